@@ -13,11 +13,35 @@
 
 #pragma once
 
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
 #include <cstdio>
 #include <cstring>
 
+#include <atomic>
+#include <cmath>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/uio.h>
+#include <unistd.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+#if defined(BITMAP_PERF_STATS)
+#include <chrono>
+#endif
+
 namespace Pixel
 {
     /*!
@@ -57,6 +81,49 @@ namespace Pixel
         uint8_t alpha;
     };
     #pragma pack(pop)
+
+    /*!
+     * @inline convert
+     * @brief Pixel format conversions between the supported layouts.
+     *
+     * @discussion Widening BGR24 to BGR32 sets the alpha channel fully opaque;
+     *             narrowing drops it. Same-type overloads are straight copies so
+     *             generic code can convert without specializing.
+     */
+    inline void convert(const BGR24 &src, BGR24 &dst) { dst = src; }
+    inline void convert(const BGR32 &src, BGR32 &dst) { dst = src; }
+
+    inline void convert(const BGR24 &src, BGR32 &dst)
+    {
+        dst.b = src.b;
+        dst.g = src.g;
+        dst.r = src.r;
+        dst.alpha = 0xFF;
+    }
+
+    inline void convert(const BGR32 &src, BGR24 &dst)
+    {
+        dst.b = src.b;
+        dst.g = src.g;
+        dst.r = src.r;
+    }
+
+    /*!
+     * @enum Channel
+     * @brief Byte index of each color channel within the supported pixel layouts.
+     *
+     * @const ChannelBlue  The blue channel byte.
+     * @const ChannelGreen The green channel byte.
+     * @const ChannelRed   The red channel byte.
+     * @const ChannelAlpha The alpha channel byte (BGR32 only).
+     */
+    enum Channel : uint8_t
+    {
+        ChannelBlue  = 0,
+        ChannelGreen = 1,
+        ChannelRed   = 2,
+        ChannelAlpha = 3,
+    };
 }; /* namespace Pixel */
 
 enum BMPError : int32_t
@@ -72,6 +139,7 @@ enum BMPError : int32_t
     BMP_UNSUPPORTED_FMT = 0xE007,
     BMP_ALREADY_INIT    = 0xE008,
     BMP_BAD_INPUT       = 0xE009,
+    BMP_FROZEN          = 0xE00A,
 };
 
 /*!
@@ -80,6 +148,370 @@ enum BMPError : int32_t
  */
 #define DEFAULT_DPI (72U)
 
+/*!
+ * @enum Filter
+ * @brief Resampling filters for @p Bitmap::resize.
+ *
+ * @const Nearest  Nearest-neighbor point sampling; fastest, blocky.
+ * @const Bilinear Triangle filter over a 2-pixel support.
+ * @const Box      Averaging filter; good for strong downscales.
+ * @const Lanczos  3-lobe windowed sinc; sharpest, widest support.
+ */
+enum class Filter : uint8_t
+{
+    Nearest,
+    Bilinear,
+    Box,
+    Lanczos,
+};
+
+/*!
+ * @enum Orientation
+ * @brief The row order a Bitmap file stores its scanlines in.
+ *
+ * @const BottomUp The format's default: the last scanline comes first in the file.
+ * @const TopDown  Signalled by a negative height: the first scanline comes first.
+ */
+enum class Orientation : uint8_t
+{
+    BottomUp,
+    TopDown,
+};
+
+/*!
+ * @constant DEFAULT_TILE_BYTES
+ * @brief Target tile footprint for parallel dispatch; sized to fit comfortably in L2.
+ */
+#define DEFAULT_TILE_BYTES (256U * 1024U)
+
+/*!
+ * @constant DEFAULT_MAX_DIMENSION
+ * @brief Default cap on a loaded image's width and height, in pixels.
+ */
+#define DEFAULT_MAX_DIMENSION (1U << 16)
+
+/*!
+ * @constant DEFAULT_MAX_PIXEL_BYTES
+ * @brief Default cap on a single load's pixel storage: 1GB.
+ */
+#define DEFAULT_MAX_PIXEL_BYTES (UINT64_C(1) << 30)
+
+/*!
+ * @struct PerfStats
+ * @brief Snapshot of one Bitmap instance's performance counters.
+ *
+ * @discussion Counters are only collected when the library is built with
+ *             -DBITMAP_PERF_STATS; otherwise every field reads zero and the
+ *             instrumentation compiles away entirely.
+ *
+ * @field load_ns       Nanoseconds spent inside load paths.
+ * @field write_ns      Nanoseconds spent inside write paths.
+ * @field get_calls     Number of per-pixel get() calls.
+ * @field set_calls     Number of per-pixel set() calls.
+ * @field oob_failures  Bounds-check failures across get()/set().
+ * @field bytes_read    Bytes read from disk.
+ * @field bytes_written Bytes written to disk.
+ * @field alloc_bytes   Bytes of pixel storage allocated.
+ */
+struct PerfStats
+{
+    uint64_t load_ns;
+    uint64_t write_ns;
+    uint64_t get_calls;
+    uint64_t set_calls;
+    uint64_t oob_failures;
+    uint64_t bytes_read;
+    uint64_t bytes_written;
+    uint64_t alloc_bytes;
+};
+
+#if defined(BITMAP_PERF_STATS)
+
+/*!
+ * @class PerfAggregator
+ * @brief Process-wide accumulation of @p PerfStats across all Bitmap instances.
+ *
+ * @discussion Instances fold their counters in at destruction (or explicitly via
+ *             @p Bitmap::flush_stats); metrics scrapers read @p snapshot.
+ */
+class PerfAggregator
+{
+public:
+    /*! @brief The process-wide aggregator. */
+    static PerfAggregator &instance()
+    {
+        static PerfAggregator agg;
+        return agg;
+    }
+
+    /*! @brief Fold one instance's counters into the process totals. */
+    void add(const PerfStats &s)
+    {
+        load_ns += s.load_ns;
+        write_ns += s.write_ns;
+        get_calls += s.get_calls;
+        set_calls += s.set_calls;
+        oob_failures += s.oob_failures;
+        bytes_read += s.bytes_read;
+        bytes_written += s.bytes_written;
+        alloc_bytes += s.alloc_bytes;
+    }
+
+    /*! @brief A coherent-enough copy of the process totals for scraping. */
+    PerfStats snapshot() const
+    {
+        PerfStats s;
+        s.load_ns = load_ns.load();
+        s.write_ns = write_ns.load();
+        s.get_calls = get_calls.load();
+        s.set_calls = set_calls.load();
+        s.oob_failures = oob_failures.load();
+        s.bytes_read = bytes_read.load();
+        s.bytes_written = bytes_written.load();
+        s.alloc_bytes = alloc_bytes.load();
+        return s;
+    }
+
+private:
+    PerfAggregator() {}
+
+    std::atomic<uint64_t> load_ns{0};
+    std::atomic<uint64_t> write_ns{0};
+    std::atomic<uint64_t> get_calls{0};
+    std::atomic<uint64_t> set_calls{0};
+    std::atomic<uint64_t> oob_failures{0};
+    std::atomic<uint64_t> bytes_read{0};
+    std::atomic<uint64_t> bytes_written{0};
+    std::atomic<uint64_t> alloc_bytes{0};
+}; /* class PerfAggregator */
+
+#define BMP_STAT_ADD(field, amount) do { perf.field += (amount); } while (0)
+
+/*! @brief Scope guard adding its lifetime in nanoseconds to a counter. */
+struct BitmapStatTimer
+{
+    explicit BitmapStatTimer(uint64_t &_dst) :
+        dst(_dst), t0(std::chrono::steady_clock::now()) {}
+
+    ~BitmapStatTimer()
+    {
+        dst += std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - t0).count();
+    }
+
+    uint64_t &dst;
+    std::chrono::steady_clock::time_point t0;
+};
+
+#define BMP_STAT_TIMER(field) BitmapStatTimer _bmp_stat_timer(perf.field)
+
+#else
+
+#define BMP_STAT_ADD(field, amount) do {} while (0)
+#define BMP_STAT_TIMER(field)
+
+#endif /* BITMAP_PERF_STATS */
+
+/*!
+ * @class BitmapView
+ * @brief A non-owning view of a rectangular window within an existing pixel array.
+ *
+ * @discussion Views are O(1) to construct and copy: they carry a base pointer, their
+ *             own width/height, and the stride of the parent image, so a crop stage
+ *             can hand a small region to a consumer without deep-copying pixels. The
+ *             view is only valid while the parent's pixel storage is alive and
+ *             unmoved. Coordinates follow the same (row, col) convention as
+ *             @p Bitmap::get / @p Bitmap::set.
+ *
+ * @tparam Pixel The type of the pixel to use. See Pixel namespace for pixel type definitions.
+ */
+template <typename Pixel>
+class BitmapView
+{
+public:
+    /*!
+     * Constructor - an empty view.
+     */
+    BitmapView() : base(nullptr), view_w(0), view_h(0), stride(0) {}
+
+    /*!
+     * Constructor
+     * @param[in] _base   The address of the window's first pixel.
+     * @param[in] _w      The window width in pixels.
+     * @param[in] _h      The window height in scanlines.
+     * @param[in] _stride The parent image's scanline pitch, in bytes (which need not
+     *                    be a multiple of the pixel size once rows are padded).
+     */
+    BitmapView(Pixel *_base, const uint32_t _w, const uint32_t _h, const uint64_t _stride) :
+        base(_base), view_w(_w), view_h(_h), stride(_stride) {}
+
+    /*!
+     * @function width
+     * @brief Get the width of the viewed window.
+     *
+     * @return The window width in pixels.
+     */
+    int32_t width() const { return view_w; }
+
+    /*!
+     * @function height
+     * @brief Get the height of the viewed window.
+     *
+     * @return The window height in scanlines.
+     */
+    int32_t height() const { return view_h; }
+
+    /*!
+     * @function get
+     * @brief Get the pixel value at a given coordinate within the window.
+     *
+     * @param[in]  row   The offset within the scanline.
+     * @param[in]  col   The scanline of the window.
+     * @param[out] pixel The pixel at @p row @p col.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError get(const uint32_t row, const uint32_t col, Pixel &pixel) const
+    {
+        if (!base)
+        {
+            return BMP_NOTINIT;
+        }
+
+        if (row >= view_w || col >= view_h)
+        {
+            return BMP_OOB;
+        }
+
+        memcpy(&pixel, line(col) + row, sizeof(pixel));
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @function set
+     * @brief Set the pixel value at a given coordinate within the window.
+     *
+     * @param[in] row   The offset within the scanline.
+     * @param[in] col   The scanline of the window.
+     * @param[in] pixel The pixel to store at @p row @p col.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError set(const uint32_t row, const uint32_t col, const Pixel &pixel)
+    {
+        if (!base)
+        {
+            return BMP_NOTINIT;
+        }
+
+        if (row >= view_w || col >= view_h)
+        {
+            return BMP_OOB;
+        }
+
+        memcpy(line(col) + row, &pixel, sizeof(pixel));
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @function row_ptr
+     * @brief Get a raw pointer to the start of a window scanline.
+     *
+     * @param[in] row The scanline index within the window.
+     *
+     * @return A pointer valid for @p width() pixels, or nullptr if out of bounds.
+     */
+    Pixel *row_ptr(const uint32_t row)
+    {
+        if (!base || row >= view_h)
+        {
+            return nullptr;
+        }
+
+        return line(row);
+    }
+
+private:
+    /*! @inline line @brief The window scanline's address, via the byte stride. */
+    inline Pixel *line(const uint32_t row) const
+    {
+        return reinterpret_cast<Pixel*>(
+            reinterpret_cast<uint8_t*>(base) + static_cast<uint64_t>(row) * stride);
+    }
+
+    Pixel *base;
+    uint32_t view_w;
+    uint32_t view_h;
+    uint64_t stride;
+}; /* class BitmapView<> */
+
+/*!
+ * @class MemoryArena
+ * @brief Interface for caller-provided pixel storage.
+ *
+ * @discussion Implementations hand out raw storage for @p pixel_array so long-running
+ *             services can back bitmaps with bump arenas or recycled slab pools instead
+ *             of the global heap. Storage obtained from an arena is never freed by
+ *             Bitmap; reclaiming it (typically wholesale) is the arena's business.
+ */
+class MemoryArena
+{
+public:
+    virtual ~MemoryArena() {}
+
+    /*!
+     * @function alloc
+     * @brief Allocate raw storage from the arena.
+     *
+     * @param[in] bytes The number of bytes required.
+     *
+     * @return A pointer to the storage, or nullptr if the arena is exhausted.
+     */
+    virtual void *alloc(const size_t bytes) = 0;
+}; /* class MemoryArena */
+
+/*!
+ * @class BumpArena
+ * @brief A trivial bump-pointer @p MemoryArena over a caller-supplied buffer.
+ *
+ * @discussion Allocations advance a cursor through the buffer; @p rewind makes the
+ *             whole buffer reusable in O(1), which is the intended per-frame teardown.
+ */
+class BumpArena : public MemoryArena
+{
+public:
+    /*!
+     * Constructor
+     * @param[in] _buffer The backing buffer to allocate from.
+     * @param[in] _size   The size of @p _buffer in bytes.
+     */
+    BumpArena(void *_buffer, const size_t _size) :
+        buffer(static_cast<uint8_t*>(_buffer)), size(_size), used(0) {}
+
+    void *alloc(const size_t bytes) override
+    {
+        if ((used + bytes) > size)
+        {
+            return nullptr;
+        }
+
+        void *p = &buffer[used];
+        used += bytes;
+        return p;
+    }
+
+    /*!
+     * @function rewind
+     * @brief Reclaim the entire buffer. All outstanding allocations become invalid.
+     */
+    void rewind() { used = 0; }
+
+private:
+    uint8_t *buffer;
+    size_t size;
+    size_t used;
+}; /* class BumpArena */
+
 /*!
  * @class Bitmap
  * @brief Object for loading, manipulating, and writing Bitmap images.
@@ -91,6 +523,13 @@ enum BMPError : int32_t
 template <typename Pixel>
 class Bitmap
 {
+    /* Companion classes built on the header structures below. */
+    template <typename> friend class BitmapStreamWriter;
+    template <typename> friend class BitmapFrameEmitter;
+
+    /* Other pixel-type instantiations, for format conversion. */
+    template <typename> friend class Bitmap;
+
         /*!
      * @enum BitmapHeader
      * @brief Possible Bitmap header formats
@@ -304,16 +743,19 @@ class Bitmap
      * @struct ColorTable
      * @brief Present only if BitsPerPixel <= 8 - importance of colors.
      *
-     * @field red_intensity
-     * @field green_intensity
+     * @note Field order matches the on-disk palette entry layout (blue, green, red,
+     *       reserved) so entries can be read directly.
+     *
      * @field blue_intensity
+     * @field green_intensity
+     * @field red_intensity
      * @field rsvd Not used.
      */
-    struct ColorTable 
+    struct ColorTable
     {
-        uint8_t red_intensity;
-        uint8_t green_intensity;
         uint8_t blue_intensity;
+        uint8_t green_intensity;
+        uint8_t red_intensity;
         uint8_t rsvd;
     };
 
@@ -322,13 +764,196 @@ public:
      * Constructor
      * @param[in] _dpi Dots per pixel in inches per metre
      */
-    Bitmap(const uint32_t _dpi = DEFAULT_DPI) : loaded(false), dpi(_dpi) {}
+    Bitmap(const uint32_t _dpi = DEFAULT_DPI) :
+        pixel_array(nullptr), loaded(false), n_pixels(0), row_stride(0), row_align(4),
+        max_dim(DEFAULT_MAX_DIMENSION), max_alloc(DEFAULT_MAX_PIXEL_BYTES),
+        dirty_tracking(false), dirty_min(UINT32_MAX), dirty_max(0), frozen(false),
+        top_down(false), n_shards(0), ownership(OwnNone), map_base(nullptr),
+        map_size(0), lazy_fp(nullptr), dpi(_dpi)
+    {
+        /* Headers are assembled by load/create; zero until then so moving or
+         * inspecting a fresh instance never reads indeterminate bytes. */
+        memset(&dib, 0, sizeof(dib));
+        memset(&file_header, 0, sizeof(file_header));
+    }
     
-    /*! 
+    /*!
      * Destructor
      */
     ~Bitmap();
 
+    /*!
+     * Move constructor - transfers pixel storage ownership in O(1).
+     * @param[in] other The instance to move from; left in the unloaded state.
+     */
+    Bitmap(Bitmap &&other) noexcept :
+        pixel_array(other.pixel_array), loaded(other.loaded), n_pixels(other.n_pixels),
+        row_stride(other.row_stride), row_align(other.row_align),
+        max_dim(other.max_dim), max_alloc(other.max_alloc),
+        dirty_tracking(other.dirty_tracking), dirty_min(other.dirty_min),
+        dirty_max(other.dirty_max), frozen(other.frozen), top_down(other.top_down),
+        n_shards(other.n_shards),
+        shard_locks(std::move(other.shard_locks)), ownership(other.ownership),
+        map_base(other.map_base), map_size(other.map_size), lazy_fp(other.lazy_fp),
+        dib(other.dib), file_header(other.file_header), dpi(other.dpi)
+    {
+        other.pixel_array = nullptr;
+        other.map_base = nullptr;
+        other.map_size = 0;
+        other.lazy_fp = nullptr;
+        other.ownership = OwnNone;
+        other.loaded = false;
+        other.n_pixels = 0;
+        other.row_stride = 0;
+        other.frozen = false;
+        other.top_down = false;
+        other.n_shards = 0;
+    }
+
+    /*!
+     * Move assignment - releases current storage and takes over @p other's in O(1).
+     * @param[in] other The instance to move from; left in the unloaded state.
+     */
+    Bitmap &operator=(Bitmap &&other) noexcept
+    {
+        if (this != &other)
+        {
+            release_storage();
+
+            pixel_array = other.pixel_array;
+            loaded = other.loaded;
+            n_pixels = other.n_pixels;
+            row_stride = other.row_stride;
+            row_align = other.row_align;
+            max_dim = other.max_dim;
+            max_alloc = other.max_alloc;
+            dirty_tracking = other.dirty_tracking;
+            dirty_min = other.dirty_min;
+            dirty_max = other.dirty_max;
+            frozen = other.frozen;
+            top_down = other.top_down;
+            n_shards = other.n_shards;
+            shard_locks = std::move(other.shard_locks);
+            ownership = other.ownership;
+            map_base = other.map_base;
+            map_size = other.map_size;
+            lazy_fp = other.lazy_fp;
+            dib = other.dib;
+            file_header = other.file_header;
+            dpi = other.dpi;
+
+            other.pixel_array = nullptr;
+            other.map_base = nullptr;
+            other.map_size = 0;
+            other.lazy_fp = nullptr;
+            other.ownership = OwnNone;
+            other.loaded = false;
+            other.n_pixels = 0;
+            other.row_stride = 0;
+            other.frozen = false;
+            other.top_down = false;
+            other.n_shards = 0;
+        }
+
+        return *this;
+    }
+
+    /* Copying would either shallow-copy pixel_array (double delete) or silently deep
+     * copy megapixels; callers that want a duplicate must do so explicitly. */
+    Bitmap(const Bitmap &) = delete;
+    Bitmap &operator=(const Bitmap &) = delete;
+
+    /*!
+     * @struct HeaderBlock
+     * @brief The complete 54-byte on-disk header prefix: file header then DIB header.
+     *
+     * @discussion Packed to the on-disk layout, so a populated block can be emitted
+     *             (or compared) with a single memcpy. See @p make_header for building
+     *             one as a compile-time constant.
+     *
+     * @field file The Bitmap file header.
+     * @field info The BITMAPINFOHEADER DIB header.
+     */
+    #pragma pack(push)  /* push current alignment to stack */
+    #pragma pack(1)     /* match the on-disk layout exactly */
+    struct HeaderBlock
+    {
+        FileHeader file;
+        BitmapInfoHeader info;
+    };
+    #pragma pack(pop)
+
+    static_assert(sizeof(HeaderBlock) == 54, "HeaderBlock must match the on-disk 54B prefix");
+
+    /*!
+     * @function make_header
+     * @brief Build the fully populated header block for a fixed geometry at compile time.
+     *
+     * @discussion For pipelines whose output geometry never changes, this folds the
+     *             field-by-field header assembly (including the floating-point DPI to
+     *             pixels-per-metre conversion) into a compile-time constant, so frame
+     *             setup reduces to copying a static 54-byte blob. E.g.:
+     *             `static constexpr auto hdr = Bitmap<Pixel::BGR24>::make_header<1920, 1080>();`
+     *
+     * @tparam W   The image width in pixels.
+     * @tparam H   The image height in scanlines.
+     * @tparam DPI The dots-per-inch setting; defaults to DEFAULT_DPI.
+     *
+     * @return The populated @p HeaderBlock.
+     */
+    template <uint32_t W, uint32_t H, uint32_t DPI = DEFAULT_DPI>
+    static constexpr HeaderBlock make_header()
+    {
+        /* C++11 constexpr: a single return with every field as a constant expression.
+         * DPI × 39.3701 inches per metre, as in init_headers. */
+        return HeaderBlock{
+            { HeaderType::BM,
+              static_cast<uint32_t>(sizeof(HeaderBlock) +
+                                    ((W * sizeof(Pixel) + 3) / 4 * 4) * H),
+              {0, 0},
+              {0, 0},
+              static_cast<uint32_t>(sizeof(HeaderBlock)) },
+            { DIBHeaderType::BITMAPINFOHEADER,
+              static_cast<int32_t>(W),
+              static_cast<int32_t>(H),
+              1,
+              static_cast<BitsPerPixel>(8 * sizeof(Pixel)),
+              Compression::BI_RGB,
+              static_cast<uint32_t>(((W * sizeof(Pixel) + 3) / 4 * 4) * H),
+              static_cast<int32_t>(DPI * 39.3701),
+              static_cast<int32_t>(DPI * 39.3701),
+              0,
+              0 }
+        };
+    }
+
+    /*!
+     * @function valid_header
+     * @brief Check that a header block describes this instance's native layout.
+     *
+     * @discussion Usable in constant expressions, so a static_assert can pin a
+     *             compile-time header, and in ordinary runtime validation.
+     *
+     * @param[in] hdr The header block to check.
+     *
+     * @return true when the block is a well-formed uncompressed header matching
+     *         this pixel type.
+     */
+    static constexpr bool valid_header(const HeaderBlock &hdr)
+    {
+        return hdr.file.header_type == HeaderType::BM &&
+               hdr.file.offset == sizeof(HeaderBlock) &&
+               hdr.file.size == hdr.file.offset + hdr.info.raw_size &&
+               hdr.info.size == DIBHeaderType::BITMAPINFOHEADER &&
+               hdr.info.color_planes == 1 &&
+               hdr.info.width > 0 &&
+               hdr.info.height > 0 &&
+               hdr.info.bbp == 8 * sizeof(Pixel) &&
+               hdr.info.compression == Compression::BI_RGB &&
+               hdr.info.raw_size == ((static_cast<uint64_t>(hdr.info.width) *
+                                      sizeof(Pixel) + 3) / 4 * 4) * hdr.info.height;
+    }
+
     /*!
      * @function load
      * @brief Load a Bitmap file into program memory. 
@@ -342,43 +967,439 @@ public:
     BMPError load(const char * const filename);
 
     /*!
-     * @function create
-     * @brief Create a new blank Bitmap image.
+     * @function load
+     * @brief Load a Bitmap file with the pixel array backed by a caller-provided arena.
+     *
+     * @discussion The arena variant skips heap allocation entirely; teardown via
+     *             @p reset or destruction abandons the storage to the arena for free.
      *
      * @param[in] filename The name of the file to load.
+     * @param[in] arena    The arena to allocate @p pixel_array from.
      *
      * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
      */
-    BMPError create(const uint64_t width, const uint64_t height);
+    BMPError load(const char * const filename, MemoryArena &arena);
 
     /*!
-     * @function write
-     * @brief Write the currently loaded file to the filesystem.
+     * @function open
+     * @brief Open a Bitmap file lazily, reading only its headers.
      *
-     * @param[in] filename The name of the file to write to.
+     * @discussion After a successful open, @p width, @p height, and the reserved-field
+     *             accessors answer immediately from the headers; the pixel payload is
+     *             read only when first touched through @p get / @p set / the bulk
+     *             accessors, or explicitly via @p ensure_pixels. Triage paths that
+     *             route on metadata never pay for the payload at all.
+     *
+     * @param[in] filename The name of the file to open.
      *
      * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
      */
-    BMPError write(const char * const filename);
+    BMPError open(const char * const filename);
 
     /*!
-     * @function width
-     * @brief Get the width of the currently loaded image.
+     * @function ensure_pixels
+     * @brief Materialize the pixel payload of a lazily opened file.
      *
-     * @return The image width. BMP_NOTINIT if not loaded.
+     * @discussion No-op if the pixels are already resident. Bulk operations that
+     *             require a loaded image (fill, blend, transforms) can be preceded by
+     *             an explicit call.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
      */
-    int32_t width() const;
+    BMPError ensure_pixels();
 
     /*!
-     * @function height
-     * @brief Get the height of the currently loaded image.
+     * @function load_async
+     * @brief Begin loading a Bitmap file on a background I/O thread.
      *
-     * @return The image height. BMP_NOTINIT if not loaded.
+     * @discussion Lets a pipeline overlap frame N's transform with frame N+1's read.
+     *             The instance must not be touched until the returned future resolves;
+     *             the completion value is exactly what the synchronous @p load would
+     *             have returned.
+     *
+     * @param[in] filename The name of the file to load.
+     *
+     * @return A future yielding the load's @p BMPError status.
      */
-    int32_t height() const;
-    
+    std::future<BMPError> load_async(const char * const filename);
+
     /*!
-     * @function get
+     * @function write_async
+     * @brief Begin writing the loaded image on a background I/O thread.
+     *
+     * @discussion The pixel data must not be mutated (and the instance not reset or
+     *             destroyed) until the returned future resolves.
+     *
+     * @param[in] filename The name of the file to write to.
+     *
+     * @return A future yielding the write's @p BMPError status.
+     */
+    std::future<BMPError> write_async(const char * const filename);
+
+    /*!
+     * @function load_mapped
+     * @brief Load a Bitmap file by memory mapping it instead of copying it into the heap.
+     *
+     * @discussion The file is mapped privately (copy-on-write) and @p pixel_array is pointed
+     *             directly at the pixel region of the mapping, honoring @p file_header.offset.
+     *             Pages are faulted in lazily by the kernel on first touch, so images that are
+     *             only sparsely read never pay for a full read or a full-size allocation.
+     *             Calls to @p set promote only the touched pages to private copies; the file
+     *             on disk is never modified through the mapping.
+     *
+     * @param[in] filename The name of the file to map.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError load_mapped(const char * const filename);
+
+    /*!
+     * @function load_region
+     * @brief Load only a rectangular window of a Bitmap file.
+     *
+     * @discussion Seeks directly to the byte range of each needed scanline segment
+     *             (derived from @p file_header.offset and the file's row pitch) and
+     *             reads just that window into a right-sized @p pixel_array, so a small
+     *             crop of a huge file costs only the window's bytes of I/O. The
+     *             instance then behaves as a @p w x @p h image in its own right,
+     *             including @p write round trips.
+     *
+     * @param[in] filename The name of the file to read from.
+     * @param[in] row      The first scanline of the window in the source image.
+     * @param[in] col      The offset of the window within each source scanline.
+     * @param[in] w        The window width in pixels.
+     * @param[in] h        The window height in scanlines.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError load_region(const char * const filename, const uint32_t row, const uint32_t col,
+                         const uint32_t w, const uint32_t h);
+
+    /*!
+     * @function create
+     * @brief Create a new blank Bitmap image.
+     *
+     * @param[in] filename The name of the file to load.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError create(const uint64_t width, const uint64_t height);
+
+    /*!
+     * @function create
+     * @brief Create a new blank Bitmap image with arena-backed pixel storage.
+     *
+     * @param[in] width  The image width in pixels.
+     * @param[in] height The image height in scanlines.
+     * @param[in] arena  The arena to allocate @p pixel_array from.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError create(const uint64_t width, const uint64_t height, MemoryArena &arena);
+
+    /*!
+     * @function create
+     * @brief Create an image from a prebuilt header block, skipping header assembly.
+     *
+     * @discussion The fast path for fixed-geometry frame producers: pair with a
+     *             compile-time @p make_header constant and per-frame setup is one
+     *             54-byte memcpy plus the pixel allocation. Unlike the geometry
+     *             overloads the pixel contents are left uninitialized; callers are
+     *             expected to overwrite every pixel before writing.
+     *
+     * @param[in] hdr The header block to adopt; validated with @p valid_header.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError create(const HeaderBlock &hdr);
+
+    /*!
+     * @function adopt
+     * @brief Wrap an existing pixel buffer as this instance's image, with zero copies.
+     *
+     * @discussion For pipelines whose upstream stage already produced pixels in its own
+     *             buffer (e.g. a decoder writing into pre-registered DMA memory):
+     *             rather than @p create plus a full-frame copy, @p pixel_array is
+     *             pointed straight at @p buffer. The buffer must hold
+     *             @p width x @p height pixels in this instance's native bottom-up
+     *             scanline layout and must outlive the adoption.
+     *
+     * @param[in] buffer         The pixel storage to adopt.
+     * @param[in] width          The image width in pixels.
+     * @param[in] height         The image height in scanlines.
+     * @param[in] take_ownership When true the destructor (or @p reset) frees @p buffer
+     *                           with delete[]; when false the caller retains ownership
+     *                           and this instance never frees it.
+     * @param[in] stride_bytes   The buffer's scanline pitch in bytes; 0 selects the
+     *                           on-disk pitch (the payload padded to 4 bytes). Must be
+     *                           at least @p width pixels of payload.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError adopt(Pixel * const buffer, const uint64_t width, const uint64_t height,
+                   const bool take_ownership = false, const uint64_t stride_bytes = 0);
+
+    /*!
+     * @function release
+     * @brief Detach and return the pixel buffer, leaving the instance unloaded.
+     *
+     * @discussion The destructor's delete[] is skipped; the caller assumes ownership of
+     *             the returned buffer (delete[] it if it was heap-allocated here).
+     *             Only heap-backed and adopted buffers can be released: mapped and
+     *             arena-backed storage is owned elsewhere and yields nullptr.
+     *
+     * @return The pixel buffer, or nullptr if there is nothing releasable.
+     */
+    Pixel *release();
+
+    /*!
+     * @function reset
+     * @brief Return the instance to the unloaded state so it can be reused.
+     *
+     * @discussion Heap-backed pixel storage is freed and mappings are unmapped;
+     *             arena-backed storage is abandoned without freeing (the arena owns
+     *             it). After reset, a subsequent @p load / @p create succeeds instead
+     *             of failing with BMP_ALREADY_INIT, so one instance can cycle through
+     *             many frames without churning the allocator.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError reset();
+
+    /*!
+     * @function write
+     * @brief Write the currently loaded file to the filesystem.
+     *
+     * @param[in] filename The name of the file to write to.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError write(const char * const filename);
+
+    /*!
+     * @function enable_dirty_tracking
+     * @brief Begin tracking which scanlines are modified by subsequent writes.
+     *
+     * @discussion With tracking on, every mutator — @p set, @p set_row, @p set_rect,
+     *             @p fill_rect, the bulk kernels (@p fill, @p set_channel, @p blend,
+     *             @p grayscale, the flips and @p transpose), and the pixel iterators —
+     *             records the touched scanline range so @p write_incremental can
+     *             rewrite only those bytes instead of the whole file. Pixels written
+     *             through @p row_ptr or a @p view are the caller's to account for.
+     */
+    void enable_dirty_tracking()
+    {
+        dirty_tracking = true;
+        dirty_min = UINT32_MAX;
+        dirty_max = 0;
+    }
+
+    /*!
+     * @function freeze
+     * @brief Mark the image immutable so concurrent reads need no synchronization.
+     *
+     * @discussion Lazily opened pixels are materialized first, so after a successful
+     *             freeze the read paths (@p get, @p get_row, @p get_rect, const
+     *             @p row_ptr) touch no mutable state and may run from any number of
+     *             threads concurrently. All mutators, @p view, and mutable @p row_ptr
+     *             then refuse with BMP_FROZEN. Freezing is one-way; @p reset clears it.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError freeze()
+    {
+        const BMPError fault = fault_in();
+        if (fault != BMP_SUCCESS)
+        {
+            return fault;
+        }
+
+        if (!loaded)
+        {
+            return BMP_NOTINIT;
+        }
+
+        frozen = true;
+
+        /* Reads need no synchronization from here on. */
+        shard_locks.reset();
+        n_shards = 0;
+
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @inline is_frozen
+     * @brief Whether @p freeze has marked this image immutable.
+     */
+    inline bool is_frozen() const { return frozen; }
+
+    /*!
+     * @function enable_shared_writes
+     * @brief Serialize mutations per scanline shard so concurrent writers to disjoint
+     *        regions do not race (or fully serialize on one lock).
+     *
+     * @discussion With shared writes on, @p set, @p set_row, @p set_rect, and
+     *             @p fill_rect take the lock of the touched scanline's shard, so
+     *             writers working different bands of the image proceed in parallel.
+     *             Readers remain lock-free; a read concurrent with a write to the
+     *             same scanline may observe a torn pixel. Whole-image mutators
+     *             (@p fill, @p grayscale, the flips, the parallel transforms) still
+     *             require exclusive access.
+     *
+     * @param[in] shards The number of lock shards; 0 selects a default of 64.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError enable_shared_writes(uint32_t shards = 0)
+    {
+        if (frozen)
+        {
+            return BMP_FROZEN;
+        }
+
+        if (shards == 0)
+        {
+            shards = 64;
+        }
+
+        shard_locks.reset(new std::mutex[shards]);
+        n_shards = shards;
+
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @function write_incremental
+     * @brief Rewrite only the dirty scanline range of an existing output file.
+     *
+     * @discussion Opens @p filename in place, seeks to the dirty scanlines (offsets
+     *             derived from @p file_header.offset and the row pitch), and rewrites
+     *             just those bytes, then clears the dirty range. The file must have
+     *             been produced by a prior @p write of this image (geometry is
+     *             verified). Falls back to a full @p write when tracking is disabled;
+     *             a clean image is a no-op.
+     *
+     * @param[in] filename The name of the existing file to update.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError write_incremental(const char * const filename);
+
+    /*!
+     * @function width
+     * @brief Get the width of the currently loaded image.
+     *
+     * @return The image width. BMP_NOTINIT if not loaded.
+     */
+    int32_t width() const;
+
+    /*!
+     * @function height
+     * @brief Get the height of the currently loaded image.
+     *
+     * @return The image height. BMP_NOTINIT if not loaded.
+     */
+    int32_t height() const;
+
+    /*!
+     * @inline stride
+     * @brief Get the in-memory scanline pitch of the current pixel storage.
+     *
+     * @discussion By default this equals the file's 4-byte-padded row pitch, so the
+     *             whole payload is load/store-able in one shot; @p set_row_alignment
+     *             can widen it. Scanline @p n starts @p n x stride() bytes into the
+     *             pixel array.
+     *
+     * @return The scanline pitch in bytes, or 0 when no storage is attached.
+     */
+    inline uint64_t stride() const { return row_stride; }
+
+    /*!
+     * @function set_row_alignment
+     * @brief Choose the boundary each in-memory scanline's start is padded to.
+     *
+     * @discussion The default of 4 matches the file format's own row padding, which
+     *             keeps the in-memory and on-disk layouts identical. Raising it (e.g.
+     *             to 64) starts every scanline on a cache-line boundary for vectorized
+     *             row kernels, at the cost of row-by-row file I/O. Takes effect on the
+     *             next allocation, so it must be called before @p load / @p create.
+     *
+     * @param[in] align The row alignment in bytes; a power of two, at least 4.
+     *
+     * @return BMP_SUCCESS upon sucess. BMP_ALREADY_INIT if an image is already
+     *         attached, BMP_BAD_INPUT for an invalid alignment.
+     */
+    BMPError set_row_alignment(const uint32_t align)
+    {
+        if (loaded || lazy_fp)
+        {
+            return BMP_ALREADY_INIT;
+        }
+
+        if (align < 4 || (align & (align - 1)) != 0)
+        {
+            return BMP_BAD_INPUT;
+        }
+
+        row_align = align;
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @function set_load_limits
+     * @brief Cap the geometry and allocation a load will accept from a file.
+     *
+     * @discussion Dimension fields come straight from untrusted bytes; a crafted
+     *             header can otherwise demand a multi-gigabyte allocation that
+     *             stalls or kills the process before the read even fails. Loads
+     *             reject any file exceeding these caps with BMP_BAD_INPUT before
+     *             allocating. The defaults (@p DEFAULT_MAX_DIMENSION per axis,
+     *             @p DEFAULT_MAX_PIXEL_BYTES of storage) admit any realistic image;
+     *             raise them deliberately for known-huge inputs.
+     *
+     * @param[in] max_dimension   The largest acceptable width or height in pixels.
+     * @param[in] max_pixel_bytes The largest pixel storage to allocate in bytes.
+     *
+     * @return BMP_SUCCESS upon sucess. BMP_ALREADY_INIT if an image is already
+     *         attached, BMP_BAD_INPUT for a zero limit.
+     */
+    BMPError set_load_limits(const uint32_t max_dimension, const uint64_t max_pixel_bytes)
+    {
+        if (loaded || lazy_fp)
+        {
+            return BMP_ALREADY_INIT;
+        }
+
+        if (max_dimension == 0 || max_pixel_bytes == 0)
+        {
+            return BMP_BAD_INPUT;
+        }
+
+        max_dim = max_dimension;
+        max_alloc = max_pixel_bytes;
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @inline orientation
+     * @brief Get the row order of the file this image was loaded from.
+     *
+     * @discussion Pixel storage is always bottom-up in memory regardless of the
+     *             file's orientation; a top-down file's rows are placed in reverse
+     *             during the load, in the same read pass, so no separate flip over
+     *             the pixels ever runs. @p write re-emits the original orientation.
+     *
+     * @return @p Orientation::TopDown when the source file used a negative height,
+     *         else @p Orientation::BottomUp (also the default for created images).
+     */
+    inline Orientation orientation() const
+    {
+        return top_down ? Orientation::TopDown : Orientation::BottomUp;
+    }
+
+    /*!
+     * @function get
      * @brief Get the pixel value at a given coordinate.
      *
      * @param[in]  row   The row coordinate to pull from.
@@ -401,274 +1422,3731 @@ public:
      */
     BMPError set(const uint64_t row, const uint64_t col, Pixel &pixel);
 
-    /*!
-     * @function WriteHeaderRsvd
-     * @brief Write to the reserved metadata field of the Bitmap file header.
-     *
-     * @param[in] data The 4B of data to write.
-     *
-     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
-     */
-    BMPError WriteHeaderRsvd(const uint8_t data[4]);
-    
-    /*!
-     * @function ReadHeaderRsvd
-     * @brief Read the reserved metadata field of the Bitmap file header.
-     *
-     * @param[out] data The 4B of data read from the reserved bytes.
-     *
-     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
-     */
-    BMPError ReadHeaderRsvd(uint8_t data[4]) const;
+    /*!
+     * @function get_row
+     * @brief Copy a span of pixels out of one scanline with a single bounds check.
+     *
+     * @discussion A scanline is @p width() contiguous pixels. Note that due to the layout
+     *             chosen by @p pixel_index, the scanline index corresponds to the @p col
+     *             argument of @p get / @p set.
+     *
+     * @param[in]  row   The scanline to copy from.
+     * @param[out] dst   Destination for the pixels. Must hold at least @p count pixels.
+     * @param[in]  count The number of pixels to copy, starting at the scanline start.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError get_row(const uint32_t row, Pixel *dst, const uint64_t count) const;
+
+    /*!
+     * @function set_row
+     * @brief Copy a span of pixels into one scanline with a single bounds check.
+     *
+     * @param[in] row   The scanline to copy into.
+     * @param[in] src   Source pixels. Must hold at least @p count pixels.
+     * @param[in] count The number of pixels to copy, starting at the scanline start.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError set_row(const uint32_t row, const Pixel *src, const uint64_t count);
+
+    /*!
+     * @function get_rect
+     * @brief Copy a rectangular window of pixels out of the image.
+     *
+     * @discussion Bounds are validated once up front; each scanline segment is then moved
+     *             with one @p memcpy. A full-width window degenerates to a single copy.
+     *
+     * @param[in]  row The first scanline of the window.
+     * @param[in]  col The offset of the window within each scanline.
+     * @param[in]  w   The window width in pixels.
+     * @param[in]  h   The window height in scanlines.
+     * @param[out] dst Destination for the pixels. Must hold at least @p w * @p h pixels.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError get_rect(const uint32_t row, const uint32_t col,
+                      const uint32_t w, const uint32_t h, Pixel *dst) const;
+
+    /*!
+     * @function set_rect
+     * @brief Copy a rectangular window of pixels into the image.
+     *
+     * @param[in] row The first scanline of the window.
+     * @param[in] col The offset of the window within each scanline.
+     * @param[in] w   The window width in pixels.
+     * @param[in] h   The window height in scanlines.
+     * @param[in] src Source pixels. Must hold at least @p w * @p h pixels.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError set_rect(const uint32_t row, const uint32_t col,
+                      const uint32_t w, const uint32_t h, const Pixel *src);
+
+    /*!
+     * @function row_ptr
+     * @brief Get a raw pointer to the start of a scanline.
+     *
+     * @discussion Escape hatch for trusted inner loops that want to skip the per-call
+     *             checks of @p get / @p set. The pointer is valid for @p width() pixels.
+     *
+     * @param[in] row The scanline index.
+     *
+     * @return A pointer to the scanline, or nullptr if not loaded or @p row is out of bounds.
+     */
+    Pixel *row_ptr(const uint32_t row);
+
+    /*!
+     * @class Unchecked
+     * @brief A zero-overhead accessor over a loaded image's pixels.
+     *
+     * @discussion The checked @p get / @p set re-test @p loaded and the pixel bounds on
+     *             every call, which the optimizer cannot hoist across the memcpy. This
+     *             accessor compiles down to a bare indexed load/store: the caller
+     *             guarantees the image is loaded and every coordinate is in bounds.
+     *             Obtain one via @p unsafe(); it is only valid while the owning
+     *             Bitmap's pixel storage is alive and unmoved.
+     */
+    class Unchecked
+    {
+    public:
+        /*!
+         * @inline at
+         * @brief Direct reference to the pixel at a coordinate. No checks.
+         */
+        inline Pixel &at(const uint32_t row, const uint32_t col) const
+        {
+            return *reinterpret_cast<Pixel*>(
+                reinterpret_cast<uint8_t*>(owner.pixel_array) + owner.pixel_index(row, col));
+        }
+
+        /*!
+         * @inline get
+         * @brief Read the pixel at a coordinate. No checks.
+         */
+        inline void get(const uint32_t row, const uint32_t col, Pixel &pixel) const
+        {
+            pixel = at(row, col);
+        }
+
+        /*!
+         * @inline set
+         * @brief Write the pixel at a coordinate. No checks.
+         */
+        inline void set(const uint32_t row, const uint32_t col, const Pixel &pixel) const
+        {
+            at(row, col) = pixel;
+        }
+
+    private:
+        friend class Bitmap;
+        explicit Unchecked(Bitmap &_owner) : owner(_owner) {}
+        Bitmap &owner;
+    }; /* class Unchecked */
+
+    /*!
+     * @function unsafe
+     * @brief Get an @p Unchecked accessor for trusted inner loops.
+     *
+     * @discussion The caller takes over the invariants the checked path verifies:
+     *             the image must be loaded and coordinates in bounds.
+     *
+     * @return An @p Unchecked accessor bound to this instance.
+     */
+    Unchecked unsafe() { return Unchecked(*this); }
+
+    /*!
+     * @function view
+     * @brief Create a non-owning view of a rectangular window of this image.
+     *
+     * @discussion The view stays valid only while this instance owns its current pixel
+     *             storage; @p reset, destruction, or moving-from invalidates it.
+     *
+     * @param[in]  row The first scanline of the window.
+     * @param[in]  col The offset of the window within each scanline.
+     * @param[in]  w   The window width in pixels.
+     * @param[in]  h   The window height in scanlines.
+     * @param[out] out The view over the window.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError view(const uint32_t row, const uint32_t col,
+                  const uint32_t w, const uint32_t h, BitmapView<Pixel> &out);
+
+    /*!
+     * @function fill
+     * @brief Fill the entire image with one pixel value.
+     *
+     * @discussion Seeds the first pixel and replicates it with exponentially doubling
+     *             copies, so the fill runs at memcpy (memory bandwidth) speed for any
+     *             pixel layout, including 3-byte packed BGR24.
+     *
+     * @param[in] pixel The pixel value to fill with.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError fill(const Pixel &pixel);
+
+    /*!
+     * @function fill_rect
+     * @brief Fill a rectangular window with one pixel value.
+     *
+     * @param[in] row   The first scanline of the window.
+     * @param[in] col   The offset of the window within each scanline.
+     * @param[in] w     The window width in pixels.
+     * @param[in] h     The window height in scanlines.
+     * @param[in] pixel The pixel value to fill with.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError fill_rect(const uint32_t row, const uint32_t col,
+                       const uint32_t w, const uint32_t h, const Pixel &pixel);
+
+    /*!
+     * @function set_channel
+     * @brief Set one color channel to a constant value across the entire image.
+     *
+     * @discussion Uses an SSE2 mask/merge kernel for 4-byte pixels; the 3-byte packed
+     *             BGR24 layout and non-SSE2 builds fall back to a strided scalar loop.
+     *
+     * @param[in] channel The channel to overwrite. See @p Pixel::Channel.
+     * @param[in] value   The byte value to store in the channel.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError set_channel(const ::Pixel::Channel channel, const uint8_t value);
+
+    /*!
+     * @function blend
+     * @brief Alpha-blend another image of identical geometry into this one.
+     *
+     * @discussion Computes dst = (dst * (255 - alpha) + src * alpha) / 255 per channel
+     *             byte, using a widening SSE2 kernel where available and exact integer
+     *             scalar math otherwise.
+     *
+     * @param[in] other The source image. Must have the same width and height.
+     * @param[in] alpha The blend weight of @p other; 0 leaves this image untouched,
+     *                  255 replaces it.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError blend(const Bitmap &other, const uint8_t alpha);
+
+    /*!
+     * @function grayscale
+     * @brief Convert the image to grayscale in place.
+     *
+     * @discussion Uses the fixed-point Rec.601 luma weights (77, 150, 29) / 256 so the
+     *             inner loop is integer-only. The alpha channel, if any, is untouched.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError grayscale();
+
+    /*!
+     * @function histogram
+     * @brief Compute per-channel 256-bin histograms over the whole image.
+     *
+     * @discussion Accumulates into four independent sub-histogram sets that are merged
+     *             at the end, so consecutive pixels never update the same counter and
+     *             the store-to-load dependency that serializes naive histogramming is
+     *             broken across iterations.
+     *
+     * @param[out] bins The counts, indexed [channel][value] with channels in
+     *                  @p Pixel::Channel order (blue, green, red).
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError histogram(uint32_t bins[3][256]) const;
+
+    /*!
+     * @function channel_minmax
+     * @brief Find the minimum and maximum value of each color channel.
+     *
+     * @discussion 32-bit pixels reduce 16 bytes per step with SSE2 byte min/max where
+     *             available; other layouts use an unrolled scalar scan.
+     *
+     * @param[out] mins The per-channel minima, in @p Pixel::Channel order.
+     * @param[out] maxs The per-channel maxima, in @p Pixel::Channel order.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError channel_minmax(uint8_t mins[3], uint8_t maxs[3]) const;
+
+    /*!
+     * @function mean
+     * @brief Compute the average value of each color channel.
+     *
+     * @discussion 32-bit pixels accumulate with masked SSE2 sum-of-absolute-differences
+     *             (one 16-byte load feeds all three channel sums) where available;
+     *             other layouts use independent scalar accumulators.
+     *
+     * @param[out] out The per-channel means, in @p Pixel::Channel order.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError mean(double out[3]) const;
+
+    /*!
+     * @function equals
+     * @brief Compare this image's pixels against another's, byte for byte.
+     *
+     * @discussion Runs one memcmp per scanline with early exit on the first
+     *             differing row, so mismatches cost only as much of the image as
+     *             matches and full compares run at memory bandwidth — no per-pixel
+     *             call overhead. Images of different geometry are simply unequal.
+     *
+     * @param[in]  other The image to compare against.
+     * @param[out] same  true when both images have identical geometry and pixels.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError equals(const Bitmap &other, bool &same) const;
+
+    /*!
+     * @function diff_count
+     * @brief Count the pixels whose color channels differ beyond a tolerance.
+     *
+     * @discussion A pixel counts as changed when any of its three color channels
+     *             differs from the other image's by more than @p tolerance. 32-bit
+     *             pixels run on SSE2 saturating absolute differences, 16 bytes per
+     *             step, where available.
+     *
+     * @param[in]  other     The image to compare against; must match in geometry.
+     * @param[in]  tolerance The largest per-channel difference considered equal.
+     * @param[out] count     The number of changed pixels.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError diff_count(const Bitmap &other, const uint8_t tolerance, uint64_t &count) const;
+
+    /*!
+     * @function diff_bounding_box
+     * @brief Find the minimal rectangle covering every differing pixel.
+     *
+     * @discussion Unchanged scanlines are skipped with a single memcmp each; only
+     *             rows that differ are scanned per pixel to tighten the horizontal
+     *             extent. The rectangle uses @p get_rect coordinates (@p row is the
+     *             first scanline, @p col the offset within a scanline), so the row
+     *             range can feed an incremental rewrite directly. When the images
+     *             are identical, @p w and @p h are 0.
+     *
+     * @param[in]  other The image to compare against; must match in geometry.
+     * @param[out] row   The first scanline of the changed window.
+     * @param[out] col   The offset of the changed window within each scanline.
+     * @param[out] w     The changed window width in pixels; 0 when identical.
+     * @param[out] h     The changed window height in scanlines; 0 when identical.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError diff_bounding_box(const Bitmap &other, uint32_t &row, uint32_t &col,
+                               uint32_t &w, uint32_t &h) const;
+
+    /*!
+     * @function convert_to
+     * @brief Convert this image into a Bitmap of a different pixel type.
+     *
+     * @discussion Widening to BGR32 sets alpha fully opaque; narrowing drops it.
+     *             For files on disk, prefer the fused load path: a Bitmap<BGR32> can
+     *             @p load a 24-bpp file directly and widen during the read, skipping
+     *             this intermediate pass entirely.
+     *
+     * @param[out] out An unloaded Bitmap of the target pixel type.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    template <typename OtherPixel>
+    BMPError convert_to(Bitmap<OtherPixel> &out) const;
+
+    /*!
+     * @function resize
+     * @brief Resample the image to a new geometry into a caller-provided Bitmap.
+     *
+     * @discussion Implemented as separable horizontal and vertical passes with filter
+     *             weights precomputed per output row/column in 14-bit fixed point, so
+     *             the inner loops are integer multiply-accumulates over the channel
+     *             bytes with no float math. Operates directly on the native BGR
+     *             layout; no intermediate format conversion.
+     *
+     * @param[in]  new_w  The output width in pixels.
+     * @param[in]  new_h  The output height in scanlines.
+     * @param[in]  filter The resampling filter. See @p Filter.
+     * @param[out] out    An unloaded Bitmap that receives the resampled image.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError resize(const uint32_t new_w, const uint32_t new_h, const Filter filter,
+                    Bitmap &out) const;
+
+    /*!
+     * @function flip_vertical
+     * @brief Reverse the scanline order of the image in place.
+     *
+     * @discussion Swaps whole scanlines through a single temporary row with memcpy,
+     *             so the pass runs at memory bandwidth. BMP files store scanlines
+     *             bottom-up; pipelines expecting top-down order flip once after load.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError flip_vertical();
+
+    /*!
+     * @function flip_horizontal
+     * @brief Reverse the pixels within each scanline in place.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError flip_horizontal();
+
+    /*!
+     * @function transpose
+     * @brief Transpose the image in place, swapping its width and height.
+     *
+     * @discussion Works in cache-sized square blocks so both the reads and the
+     *             strided writes stay resident while a block is processed, instead of
+     *             thrashing the cache the way a naive element-at-a-time transpose
+     *             does. The pixel storage is reallocated on the heap.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError transpose();
+
+    /*!
+     * @function for_each_pixel
+     * @brief Invoke a callable for every pixel, always walking memory contiguously.
+     *
+     * @discussion Iteration order is scanline-major regardless of how the caller
+     *             would have expressed the loop, so the traversal never strides.
+     *
+     * @param[in] fn Callable invoked as fn(row, col, Pixel &) with the same
+     *               coordinate convention as @p get / @p set.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    template <typename Fn>
+    BMPError for_each_pixel(const Fn &fn);
+
+    /*!
+     * @function for_each_tile
+     * @brief Partition the image into tiles and dispatch them across a worker pool.
+     *
+     * @discussion Tiles are handed out to workers via an atomic cursor, so load balances
+     *             even when per-tile work is uneven. Edge tiles are clamped to the image.
+     *             @p fn must be safe to invoke concurrently from multiple threads; tiles
+     *             never overlap, so disjoint pixel writes need no synchronization.
+     *
+     * @param[in] tile_w    The tile width in pixels. Sized so a tile fits in L2 for best results.
+     * @param[in] tile_h    The tile height in scanlines.
+     * @param[in] fn        Callable invoked as fn(row, col, w, h) per tile, with the same
+     *                      coordinate convention as @p get_rect.
+     * @param[in] n_threads Worker count; 0 selects the hardware concurrency.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    template <typename Fn>
+    BMPError for_each_tile(const uint32_t tile_w, const uint32_t tile_h, const Fn &fn,
+                           uint32_t n_threads = 0);
+
+    /*!
+     * @function transform_parallel
+     * @brief Apply a per-pixel transform to the whole image across a worker pool.
+     *
+     * @discussion The image is split into full-width scanline bands sized to fit in L2,
+     *             and each band is walked in contiguous memory order.
+     *
+     * @param[in] fn        Callable invoked as fn(Pixel &) for every pixel. Must be safe
+     *                      to invoke concurrently from multiple threads.
+     * @param[in] n_threads Worker count; 0 selects the hardware concurrency.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    template <typename Fn>
+    BMPError transform_parallel(const Fn &fn, uint32_t n_threads = 0);
+
+    /*!
+     * @function WriteHeaderRsvd
+     * @brief Write to the reserved metadata field of the Bitmap file header.
+     *
+     * @param[in] data The 4B of data to write.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError WriteHeaderRsvd(const uint8_t data[4]);
+    
+    /*!
+     * @function ReadHeaderRsvd
+     * @brief Read the reserved metadata field of the Bitmap file header.
+     *
+     * @param[out] data The 4B of data read from the reserved bytes.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError ReadHeaderRsvd(uint8_t data[4]) const;
+
+    /*!
+     * @function stats
+     * @brief Snapshot this instance's performance counters.
+     *
+     * @discussion Counters accumulate only when built with -DBITMAP_PERF_STATS;
+     *             otherwise every field reads zero and no collection code exists.
+     *
+     * @return The counters accumulated since construction or the last @p flush_stats.
+     */
+    PerfStats stats() const
+    {
+#if defined(BITMAP_PERF_STATS)
+        return perf;
+#else
+        PerfStats zero;
+        memset(&zero, 0, sizeof(zero));
+        return zero;
+#endif
+    }
+
+    /*!
+     * @function flush_stats
+     * @brief Fold this instance's counters into the process-wide @p PerfAggregator
+     *        and zero them. A no-op unless built with -DBITMAP_PERF_STATS.
+     */
+    void flush_stats()
+    {
+#if defined(BITMAP_PERF_STATS)
+        PerfAggregator::instance().add(perf);
+        memset(&perf, 0, sizeof(perf));
+#endif
+    }
+
+protected:
+    /*!
+     * @inline pixel_index
+     * @brief Get the byte offset of a pixel within @p pixel_array from 2D coordinates.
+     *
+     * @discussion Byte-based because scanlines are padded to @p row_stride, which need
+     *             not be a multiple of the pixel size (e.g. 24-bit pixels with 4-byte
+     *             row alignment).
+     *
+     * @param[in] row The row coordinate (offset within the scanline).
+     * @param[in] col The column coordinate (the scanline index).
+     *
+     * @return The 2D --> byte-offset pixel map.
+     */
+    inline uint64_t pixel_index(const int32_t row, const int32_t col) const
+    {
+        return static_cast<uint64_t>(row) * sizeof(Pixel) +
+               static_cast<uint64_t>(col) * row_stride;
+    }
+
+    /*!
+     * @inline disk_pitch
+     * @brief The on-disk scanline pitch for a width: rows pad to 4 bytes per the spec.
+     */
+    static inline uint64_t disk_pitch(const uint64_t width)
+    {
+        return (width * sizeof(Pixel) + 3) & ~static_cast<uint64_t>(3);
+    }
+
+    /*!
+     * @inline aligned_stride
+     * @brief The in-memory scanline stride for a width under this instance's row alignment.
+     */
+    inline uint64_t aligned_stride(const uint64_t width) const
+    {
+        const uint64_t payload = width * sizeof(Pixel);
+        return (payload + row_align - 1) / row_align * row_align;
+    }
+
+    /*!
+     * @inline pixel_max
+     * @brief Get the max number of the pixel data array.
+     *
+     * @return The number of pixels.
+     */
+    inline uint64_t pixel_max() const
+    {
+        return n_pixels;
+    }
+
+    /*!
+     * @inline scanline
+     * @brief Get the address of the first pixel of a scanline. No bounds checking.
+     *
+     * @param[in] row The scanline index.
+     *
+     * @return The address of pixel 0 of scanline @p row, @p row_stride bytes apart.
+     */
+    inline Pixel *scanline(const uint32_t row) const
+    {
+        return reinterpret_cast<Pixel*>(
+            reinterpret_cast<uint8_t*>(pixel_array) + static_cast<uint64_t>(row) * row_stride);
+    }
+
+    /*!
+     * @inline file_line
+     * @brief Map a file-order row index to its in-memory scanline index.
+     *
+     * @discussion An identity map for bottom-up files. For a top-down file the rows
+     *             are placed (and emitted) in reverse so memory stays bottom-up.
+     */
+    inline uint32_t file_line(const uint32_t line) const
+    {
+        return top_down ? (static_cast<uint32_t>(dib.height) - 1 - line) : line;
+    }
+
+    /*!
+     * @var pixel_array
+     * @brief A pointer to the internal pixel data of the Bitmap image.
+     */
+    Pixel *pixel_array;
+
+    /*!
+     * @var loaded
+     * @brief A flag to indicate that a Bitmap image has been loaded by this instance.
+     */
+    bool loaded;
+
+    /*!
+     * @var n_pixels
+     * @brief The pixel count, cached when an image is attached so the hot-path bounds
+     *        check does not re-multiply width and height on every call.
+     */
+    uint64_t n_pixels;
+
+    /*!
+     * @var row_stride
+     * @brief The in-memory scanline pitch in bytes; 0 when no image is attached.
+     */
+    uint64_t row_stride;
+
+    /*!
+     * @var row_align
+     * @brief The requested scanline alignment; 4 (the spec's padding) by default.
+     */
+    uint32_t row_align;
+
+    /*!
+     * @var max_dim
+     * @brief The largest width or height a load will accept, in pixels.
+     */
+    uint32_t max_dim;
+
+    /*!
+     * @var max_alloc
+     * @brief The largest pixel storage a load will attempt to allocate, in bytes.
+     */
+    uint64_t max_alloc;
+
+    /*!
+     * @var dirty_tracking
+     * @brief Whether mutations record the dirty scanline range for incremental writes.
+     */
+    bool dirty_tracking;
+
+    /*!
+     * @var dirty_min
+     * @brief First dirty scanline; UINT32_MAX when clean.
+     */
+    uint32_t dirty_min;
+
+    /*!
+     * @var dirty_max
+     * @brief Last dirty scanline (inclusive).
+     */
+    uint32_t dirty_max;
+
+    /*!
+     * @var frozen
+     * @brief Whether @p freeze has marked the image immutable.
+     */
+    bool frozen;
+
+    /*!
+     * @var top_down
+     * @brief Whether the source file stored its rows top-down (negative height).
+     *
+     * @discussion In memory rows are always kept bottom-up; this flag only records
+     *             the file's orientation so the load places rows in reverse and a
+     *             write re-emits the same orientation.
+     */
+    bool top_down;
+
+    /*!
+     * @var n_shards
+     * @brief The shard count when shared writes are enabled, else 0.
+     */
+    uint32_t n_shards;
+
+    /*!
+     * @var shard_locks
+     * @brief The per-shard scanline locks; held in a unique_ptr so the instance
+     *        stays movable (mutexes themselves are neither movable nor copyable).
+     */
+    std::unique_ptr<std::mutex[]> shard_locks;
+
+    /*!
+     * @inline line_guard
+     * @brief Take the shard lock covering a scanline, or an empty guard when
+     *        shared writes are disabled.
+     */
+    inline std::unique_lock<std::mutex> line_guard(const uint32_t line)
+    {
+        if (shard_locks)
+        {
+            return std::unique_lock<std::mutex>(shard_locks[line % n_shards]);
+        }
+
+        return std::unique_lock<std::mutex>();
+    }
+
+#if defined(BITMAP_PERF_STATS)
+    /*!
+     * @var perf
+     * @brief This instance's performance counters; mutable so const accessors count.
+     */
+    mutable PerfStats perf = {};
+#endif
+
+    /*!
+     * @inline mark_dirty
+     * @brief Widen the dirty scanline range to cover [first, last].
+     */
+    inline void mark_dirty(const uint32_t first, const uint32_t last)
+    {
+        if (dirty_tracking)
+        {
+            if (first < dirty_min)
+            {
+                dirty_min = first;
+            }
+            if (last > dirty_max)
+            {
+                dirty_max = last;
+            }
+        }
+    }
+
+    /*!
+     * @enum Ownership
+     * @brief How @p pixel_array storage was obtained, and so how it must be released.
+     *
+     * @const OwnNone   No storage attached.
+     * @const OwnHeap   new[]-allocated; released with delete[].
+     * @const OwnMapped Points into a file mapping; released with munmap.
+     * @const OwnArena  Allocated from a caller's @p MemoryArena; never freed here.
+     * @const OwnExternal Adopted from the caller without ownership; never freed here.
+     * @const OwnAligned Allocated with posix_memalign for over-sized row alignment;
+     *                   freed with free().
+     */
+    enum Ownership : uint8_t
+    {
+        OwnNone,
+        OwnHeap,
+        OwnMapped,
+        OwnArena,
+        OwnExternal,
+        OwnAligned,
+    };
+
+    /*!
+     * @var ownership
+     * @brief The release discipline for the current @p pixel_array storage.
+     */
+    Ownership ownership;
+
+    /*!
+     * @function alloc_pixels
+     * @brief Allocate strided @p pixel_array storage from the heap or a caller's arena.
+     *
+     * @discussion Sets @p row_stride to the width's payload rounded up to
+     *             @p row_align, and sizes the block as @p height such rows. Alignments
+     *             beyond what operator new guarantees come from posix_memalign; arena
+     *             blocks are over-requested and the base rounded up instead.
+     *
+     * @param[in] width  The image width in pixels.
+     * @param[in] height The image height in scanlines.
+     * @param[in] arena  The arena to allocate from, or nullptr for the heap.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError alloc_pixels(const uint64_t width, const uint64_t height, MemoryArena *arena)
+    {
+        row_stride = aligned_stride(width);
+        const uint64_t bytes = row_stride * height;
+
+        if (arena)
+        {
+            uint8_t *raw = static_cast<uint8_t*>(arena->alloc(bytes + row_align - 1));
+            if (raw)
+            {
+                const uintptr_t base = reinterpret_cast<uintptr_t>(raw);
+                const uintptr_t aligned = (base + row_align - 1) / row_align * row_align;
+                pixel_array = reinterpret_cast<Pixel*>(aligned);
+            }
+            ownership = OwnArena;
+        }
+        else if (row_align <= alignof(std::max_align_t))
+        {
+            pixel_array = new Pixel[(bytes + sizeof(Pixel) - 1) / sizeof(Pixel)];
+            ownership = OwnHeap;
+        }
+        else
+        {
+            void *raw = nullptr;
+            if (posix_memalign(&raw, row_align, bytes) != 0)
+            {
+                raw = nullptr;
+            }
+            pixel_array = static_cast<Pixel*>(raw);
+            ownership = OwnAligned;
+        }
+
+        if (!pixel_array)
+        {
+            row_stride = 0;
+            return BMP_OOM;
+        }
+
+        BMP_STAT_ADD(alloc_bytes, bytes);
+
+        n_pixels = width * height;
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @inline fault_in
+     * @brief Materialize lazily opened pixels before an accessor touches them.
+     *
+     * @discussion Logically const: faulting the payload in does not change the image
+     *             a const accessor observes, hence the cast.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    inline BMPError fault_in() const
+    {
+        if (!loaded && lazy_fp)
+        {
+            return const_cast<Bitmap*>(this)->ensure_pixels();
+        }
+
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @function release_storage
+     * @brief Release @p pixel_array according to its @p Ownership discipline.
+     */
+    void release_storage()
+    {
+        if (lazy_fp)
+        {
+            fclose(lazy_fp);
+            lazy_fp = nullptr;
+        }
+
+        switch (ownership)
+        {
+            case OwnHeap:
+                delete[] pixel_array;
+                break;
+            case OwnAligned:
+                free(pixel_array);
+                break;
+            case OwnMapped:
+                munmap(map_base, map_size);
+                break;
+            case OwnArena:    /* the arena owns the storage */
+            case OwnExternal: /* the adopting caller owns the storage */
+            case OwnNone:
+                break;
+        }
+
+        pixel_array = nullptr;
+        map_base = nullptr;
+        map_size = 0;
+        n_pixels = 0;
+        row_stride = 0;
+        ownership = OwnNone;
+    }
+
+    /*!
+     * @function parse_headers
+     * @brief Read and validate the file header and DIB header from an open file.
+     *
+     * @param[in] fptr An open file stream positioned at the start of the file.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError parse_headers(FILE *fptr);
+
+    /*!
+     * @function read_pixels
+     * @brief Read the native uncompressed payload into the strided pixel array.
+     *
+     * @discussion When the in-memory stride equals the file's 4-byte-padded pitch the
+     *             whole payload lands in one read; otherwise each scanline's payload
+     *             is read and the file padding skipped.
+     *
+     * @param[in] fptr The open file; seeks to the pixel data itself.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError read_pixels(FILE *fptr)
+    {
+        if (fseek(fptr, file_header.offset, SEEK_SET) != 0)
+        {
+            return BMP_FILEERROR;
+        }
+
+        const uint64_t pitch = disk_pitch(dib.width);
+        if (row_stride == pitch && !top_down)
+        {
+            if (fread((void*)pixel_array, pitch * dib.height, 1, fptr) != 1)
+            {
+                return BMP_FILEERROR;
+            }
+
+            return BMP_SUCCESS;
+        }
+
+        /* Row by row: either the in-memory stride differs from the file pitch, or
+         * a top-down file's rows land in reverse to keep memory bottom-up. */
+        const uint64_t read_len = (row_stride == pitch)
+                                      ? pitch
+                                      : static_cast<uint64_t>(dib.width) * sizeof(Pixel);
+        const long skip = pitch - read_len;
+        for (uint32_t y = 0; y < static_cast<uint32_t>(dib.height); y++)
+        {
+            if (fread((void*)scanline(file_line(y)), read_len, 1, fptr) != 1 ||
+                (skip > 0 && fseek(fptr, skip, SEEK_CUR) != 0))
+            {
+                return BMP_FILEERROR;
+            }
+        }
+
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @function writev_full
+     * @brief Write an iovec array to a descriptor in full, resuming partial writes.
+     *
+     * @discussion Partial writes are rare (pipe/NFS cases); the loop advances past
+     *             completed segments and trims the one a short write landed in.
+     *
+     * @param[in] fd        The destination descriptor.
+     * @param[in] iov       The segments to write; consumed (modified) by the call.
+     * @param[in] iov_count The number of segments.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    static BMPError writev_full(const int fd, struct iovec *iov, int iov_count)
+    {
+        size_t remaining = 0;
+        for (int i = 0; i < iov_count; i++)
+        {
+            remaining += iov[i].iov_len;
+        }
+
+        struct iovec *head = iov;
+        while (remaining > 0)
+        {
+            const ssize_t wrote = writev(fd, head, iov_count);
+            if (wrote < 0)
+            {
+                return BMP_FILEERROR;
+            }
+
+            remaining -= wrote;
+
+            size_t skip = wrote;
+            while (iov_count > 0 && skip >= head->iov_len)
+            {
+                skip -= head->iov_len;
+                head++;
+                iov_count--;
+            }
+            if (iov_count > 0 && skip > 0)
+            {
+                head->iov_base = static_cast<uint8_t*>(head->iov_base) + skip;
+                head->iov_len -= skip;
+            }
+        }
+
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @function load_common
+     * @brief Shared implementation for the heap- and arena-backed @p load overloads.
+     *
+     * @param[in] filename The name of the file to load.
+     * @param[in] arena    The arena to allocate from, or nullptr for the heap.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError load_common(const char * const filename, MemoryArena *arena);
+
+    /*!
+     * @inline check_native_format
+     * @brief Verify the parsed headers describe this instance's native pixel layout.
+     *
+     * @return BMP_SUCCESS if the file is uncompressed with matching bits per pixel,
+     *         else BMP_UNSUPPORTED_FMT.
+     */
+    inline BMPError check_native_format() const
+    {
+        if (dib.bbp != 8 * sizeof(Pixel) || dib.compression != Compression::BI_RGB)
+        {
+            return BMP_UNSUPPORTED_FMT;
+        }
+
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @function validate_payload
+     * @brief Check that the file really contains the payload its headers promise.
+     *
+     * @discussion A truncated or size-lying file otherwise fails deep inside the
+     *             read, after a full allocation and a partial fread. The declared
+     *             sizes are checked against the geometry, and the file's actual
+     *             length (one seek to the end) against the payload it must carry.
+     *
+     * @param[in] fptr       The open file; its position is preserved.
+     * @param[in] file_pitch The on-disk pitch of one scanline for the stored format.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError validate_payload(FILE *fptr, const uint64_t file_pitch) const
+    {
+        /* Pixel data cannot start inside the headers. */
+        if (file_header.offset < sizeof(FileHeader) + dib.size)
+        {
+            return BMP_BAD_INPUT;
+        }
+
+        /* parse_headers capped stride * height, so this cannot overflow. */
+        const uint64_t payload = file_pitch * dib.height;
+        const uint64_t need = file_header.offset + payload;
+
+        /* The declared sizes must cover the geometry they claim to describe;
+         * either field may legally be left zero by sloppy writers. */
+        if ((file_header.size != 0 && file_header.size < need) ||
+            (dib.raw_size != 0 && dib.raw_size < payload))
+        {
+            return BMP_BAD_INPUT;
+        }
+
+        const long pos = ftell(fptr);
+        if (pos < 0 || fseek(fptr, 0, SEEK_END) != 0)
+        {
+            return BMP_FILEERROR;
+        }
+
+        const long end = ftell(fptr);
+        if (fseek(fptr, pos, SEEK_SET) != 0)
+        {
+            return BMP_FILEERROR;
+        }
+
+        return (end >= 0 && static_cast<uint64_t>(end) >= need) ? BMP_SUCCESS
+                                                                : BMP_BAD_INPUT;
+    }
+
+    /*!
+     * @inline from_rgb
+     * @brief Build a pixel from 8-bit color intensities. Fields beyond b/g/r are zeroed.
+     */
+    static inline Pixel from_rgb(const uint8_t r, const uint8_t g, const uint8_t b)
+    {
+        Pixel p;
+        memset(&p, 0, sizeof(p));
+        p.b = b;
+        p.g = g;
+        p.r = r;
+        return p;
+    }
+
+    /*!
+     * @constant RESAMPLE_FRAC_BITS
+     * @brief Fixed-point fraction bits for resampling weights (sum = 1 << bits).
+     */
+    static const int RESAMPLE_FRAC_BITS = 14;
+
+    /*!
+     * @function build_taps
+     * @brief Precompute one axis's resampling taps in fixed point.
+     *
+     * @discussion For every output coordinate, computes the first contributing source
+     *             coordinate and @p n_taps normalized weights. Float math is confined
+     *             to this setup step. When downscaling, the filter support is widened
+     *             by the scale factor so the kernel averages rather than skips.
+     *
+     * @param[in]  src_size The source extent along the axis.
+     * @param[in]  dst_size The output extent along the axis.
+     * @param[in]  filter   The resampling filter.
+     * @param[out] starts   Per output coordinate, the first source coordinate.
+     * @param[out] weights  Per output coordinate, @p n_taps fixed-point weights.
+     * @param[out] n_taps   The tap count shared by every output coordinate.
+     */
+    static void build_taps(const uint32_t src_size, const uint32_t dst_size,
+                           const Filter filter, std::vector<uint32_t> &starts,
+                           std::vector<int32_t> &weights, uint32_t &n_taps)
+    {
+        const double scale = static_cast<double>(src_size) / dst_size;
+        const double filter_scale = (scale > 1.0) ? scale : 1.0;
+
+        double support = 1.0; /* Bilinear */
+        if (filter == Filter::Box)
+        {
+            support = 0.5;
+        }
+        else if (filter == Filter::Lanczos)
+        {
+            support = 3.0;
+        }
+        support *= filter_scale;
+
+        n_taps = static_cast<uint32_t>(ceil(support * 2.0));
+        if (n_taps == 0)
+        {
+            n_taps = 1;
+        }
+        if (n_taps > 64)
+        {
+            n_taps = 64;
+        }
+
+        starts.resize(dst_size);
+        weights.resize(static_cast<size_t>(dst_size) * n_taps);
+
+        for (uint32_t i = 0; i < dst_size; i++)
+        {
+            const double center = (i + 0.5) * scale;
+            int64_t first = static_cast<int64_t>(floor(center - support + 0.5));
+            if (first < 0)
+            {
+                first = 0;
+            }
+            if (first > static_cast<int64_t>(src_size - 1))
+            {
+                first = src_size - 1;
+            }
+            starts[i] = static_cast<uint32_t>(first);
+
+            double acc = 0.0;
+            double raw[64];
+            for (uint32_t k = 0; k < n_taps && k < 64; k++)
+            {
+                const uint32_t sx = ((first + k) < src_size) ? (first + k) : (src_size - 1);
+                const double t = ((sx + 0.5) - center) / filter_scale;
+                double wgt = 0.0;
+
+                switch (filter)
+                {
+                    case Filter::Box:
+                        wgt = (fabs(t) <= 0.5) ? 1.0 : 0.0;
+                        break;
+                    case Filter::Lanczos:
+                        if (fabs(t) < 3.0)
+                        {
+                            wgt = (t == 0.0) ? 1.0
+                                : (3.0 * sin(M_PI * t) * sin(M_PI * t / 3.0)) /
+                                  (M_PI * M_PI * t * t);
+                        }
+                        break;
+                    case Filter::Bilinear:
+                    case Filter::Nearest:
+                    default:
+                        wgt = (fabs(t) < 1.0) ? (1.0 - fabs(t)) : 0.0;
+                        break;
+                }
+
+                raw[k] = wgt;
+                acc += wgt;
+            }
+
+            /* Normalize so each output pixel's weights sum to exactly one. */
+            if (acc <= 0.0)
+            {
+                acc = 1.0;
+                raw[0] = 1.0;
+                for (uint32_t k = 1; k < n_taps && k < 64; k++)
+                {
+                    raw[k] = 0.0;
+                }
+            }
+
+            int32_t fixed_sum = 0;
+            for (uint32_t k = 0; k < n_taps; k++)
+            {
+                const int32_t f = static_cast<int32_t>(
+                    floor(raw[k] / acc * (1 << RESAMPLE_FRAC_BITS) + 0.5));
+                weights[static_cast<size_t>(i) * n_taps + k] = f;
+                fixed_sum += f;
+            }
+            /* Push rounding drift into the center tap. */
+            weights[static_cast<size_t>(i) * n_taps + n_taps / 2] +=
+                (1 << RESAMPLE_FRAC_BITS) - fixed_sum;
+        }
+    }
+
+    /*!
+     * @function load_widen24
+     * @brief Read a 24-bpp payload, widening each pixel to this instance's layout.
+     *
+     * @discussion Scanlines stream through a one-row staging buffer (honoring the
+     *             file's 4-byte row padding) so no intermediate full-size 24-bit
+     *             allocation or second conversion pass is ever needed.
+     *
+     * @param[in] fptr  The open file, positioned just past the DIB header.
+     * @param[in] arena The arena to allocate from, or nullptr for the heap.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError load_widen24(FILE *fptr, MemoryArena *arena);
+
+    /*!
+     * @function decode_rle8
+     * @brief Decompress a BI_RLE8 palettized payload directly into @p pixel_array.
+     *
+     * @discussion Expands runs through a 256-entry pixel lookup table built from the
+     *             file's @p ColorTable, handling the end-of-line, end-of-bitmap,
+     *             delta, and absolute-mode escapes.
+     *
+     * @param[in] fptr  The open file, positioned just past the DIB header.
+     * @param[in] arena The arena to allocate from, or nullptr for the heap.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError decode_rle8(FILE *fptr, MemoryArena *arena);
+
+    /*!
+     * @function decode_bitfields16
+     * @brief Unpack a 16-bit BI_BITFIELDS payload directly into @p pixel_array.
+     *
+     * @discussion Derives shift and width from each channel mask, precomputes
+     *             per-channel expansion tables to 8 bits, and then unpacks each
+     *             scanline with a branch-light table-lookup loop.
+     *
+     * @param[in] fptr  The open file, positioned just past the DIB header.
+     * @param[in] arena The arena to allocate from, or nullptr for the heap.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError decode_bitfields16(FILE *fptr, MemoryArena *arena);
+
+    /*!
+     * @function create_common
+     * @brief Shared implementation for the heap- and arena-backed @p create overloads.
+     *
+     * @param[in] width  The image width in pixels.
+     * @param[in] height The image height in scanlines.
+     * @param[in] arena  The arena to allocate from, or nullptr for the heap.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError create_common(const uint64_t width, const uint64_t height, MemoryArena *arena);
+
+    /*!
+     * @function init_headers
+     * @brief Populate the file and DIB headers for a fresh image of the given geometry.
+     *
+     * @param[in] width  The image width in pixels.
+     * @param[in] height The image height in scanlines.
+     */
+    void init_headers(const uint64_t width, const uint64_t height)
+    {
+        file_header.header_type = Bitmap::HeaderType::BM;
+        file_header._rsvd1[0] = file_header._rsvd1[1] = 0;
+        file_header._rsvd2[0] = file_header._rsvd2[1] = 0;
+
+        dib.raw_size = disk_pitch(width) * height;
+
+        file_header.offset = DIBHeaderType::BITMAPINFOHEADER + sizeof(FileHeader);
+        file_header.size = file_header.offset + dib.raw_size;
+
+        dib.size = DIBHeaderType::BITMAPINFOHEADER;
+        dib.height = height;
+        dib.width = width;
+        dib.color_planes = 1;
+        dib.bbp = static_cast<Bitmap::BitsPerPixel>(8 * sizeof(Pixel));
+        dib.compression = Bitmap::Compression::BI_RGB;
+        dib.n_colors = 0;
+        dib.icolors = 0;
+
+        // DPI × 39.3701 inches per metre
+        dib.vres = static_cast<uint32_t>(dpi * 39.3701);
+        dib.hres = dib.vres;
+    }
+
+private:
+    /*!
+     * @var map_base
+     * @brief Base address of the file mapping when loaded via @p load_mapped, else nullptr.
+     */
+    void *map_base;
+
+    /*!
+     * @var map_size
+     * @brief Length in bytes of the file mapping when loaded via @p load_mapped.
+     */
+    size_t map_size;
+
+    /*!
+     * @var lazy_fp
+     * @brief Open stream of a lazily opened file whose pixels are not yet resident.
+     */
+    FILE *lazy_fp;
+
+    /*!
+     * @var dib
+     * @brief The Device Independent header for this Bitmap image.
+     */
+    BitmapInfoHeader dib;
+    
+    /*!
+     * @var file_header
+     * @brief The file header for this Bitmap image.
+     */
+    FileHeader file_header;
+
+    /*!
+     * @var dpi
+     * @brief Dots per inch setting for this instance.
+     */
+    uint32_t dpi;
+}; /* class Bitmap<> */
+
+/* Templated Base Class Definitions */
+
+template <typename Pixel>
+Bitmap<Pixel>::~Bitmap()
+{
+    flush_stats();
+    release_storage();
+
+    memset(&dib, 0, sizeof(dib));
+    memset(&file_header, 0, sizeof(file_header));
+
+    loaded = false;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::reset()
+{
+    release_storage();
+
+    memset(&dib, 0, sizeof(dib));
+    memset(&file_header, 0, sizeof(file_header));
+
+    loaded = false;
+    frozen = false;
+    top_down = false;
+    shard_locks.reset();
+    n_shards = 0;
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::parse_headers(FILE *fptr)
+{
+    fread(&file_header, sizeof(file_header), 1, fptr);
+
+    if (file_header.header_type != Bitmap::HeaderType::BM)
+    {
+        return BMP_INVALID_HDR;
+    }
+
+    fread((void*)&dib, DIBHeaderType::BITMAPINFOHEADER, 1, fptr);
+    if (dib.size != DIBHeaderType::BITMAPINFOHEADER)
+    {
+        return BMP_UNSUPPORTED_FMT;
+    }
+
+    if (dib.color_planes != 1)
+    {
+        return BMP_INVALID_DIB;
+    }
+
+    /* A negative height legally marks a top-down file; normalize the field and
+     * record the orientation so row placement can compensate. */
+    if (dib.height < 0)
+    {
+        if (dib.height == INT32_MIN)
+        {
+            return BMP_INVALID_DIB;
+        }
+
+        top_down = true;
+        dib.height = -dib.height;
+    }
+    else
+    {
+        top_down = false;
+    }
+
+    /* Dimension fields are untrusted bytes: fail hostile or corrupt geometry
+     * here, in microseconds, before any allocation is sized from it. The
+     * division form of the storage check cannot overflow. */
+    if (dib.width <= 0 || dib.height == 0 ||
+        static_cast<uint32_t>(dib.width) > max_dim ||
+        static_cast<uint32_t>(dib.height) > max_dim)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    if (static_cast<uint64_t>(dib.height) > max_alloc / aligned_stride(dib.width))
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    // Assuming dib.vres == dib.hres
+    dpi = dib.hres;
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::load_common(const char * const filename, MemoryArena *arena)
+{
+    BMP_STAT_TIMER(load_ns);
+
+    if (loaded)
+    {
+        return BMP_ALREADY_INIT;
+    }
+
+    FILE *fptr = fopen(filename, "rb");
+    if (!fptr)
+    {
+        return BMP_FILEERROR;
+    }
+
+    BMPError err = parse_headers(fptr);
+    if (err != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return err;
+    }
+
+    if (check_native_format() == BMP_SUCCESS)
+    {
+        err = validate_payload(fptr, disk_pitch(dib.width));
+        if (err != BMP_SUCCESS)
+        {
+            fclose(fptr);
+            return err;
+        }
+
+        err = alloc_pixels(dib.width, dib.height, arena);
+        if (err != BMP_SUCCESS)
+        {
+            fclose(fptr);
+            return err;
+        }
+
+        err = read_pixels(fptr);
+        if (err != BMP_SUCCESS)
+        {
+            fclose(fptr);
+            release_storage();
+            return err;
+        }
+    }
+    else if (dib.bbp == BitsPerPixel::RGB24 && dib.compression == Compression::BI_RGB &&
+             sizeof(Pixel) == sizeof(::Pixel::BGR32))
+    {
+        /* Fused widening: stream the 24-bpp payload through a one-row staging
+         * buffer straight into the 32-bit array, in the same single read pass. */
+        err = load_widen24(fptr, arena);
+    }
+    else if (dib.bbp == BitsPerPixel::Palletized8 && dib.compression == Compression::BI_RLE8)
+    {
+        err = decode_rle8(fptr, arena);
+    }
+    else if (dib.bbp == BitsPerPixel::RGB16 && dib.compression == Compression::BI_BITFIELDS)
+    {
+        err = decode_bitfields16(fptr, arena);
+    }
+    else
+    {
+        err = BMP_UNSUPPORTED_FMT;
+    }
+
+    fclose(fptr);
+
+    if (err != BMP_SUCCESS)
+    {
+        release_storage();
+        return err;
+    }
+
+    /* Decoded payloads are now in this instance's native layout; normalize the
+     * headers so a subsequent write() emits a valid uncompressed file. */
+    dib.bbp = static_cast<BitsPerPixel>(8 * sizeof(Pixel));
+    dib.compression = Compression::BI_RGB;
+    dib.raw_size = disk_pitch(dib.width) * dib.height;
+    dib.n_colors = 0;
+    dib.icolors = 0;
+    file_header.offset = DIBHeaderType::BITMAPINFOHEADER + sizeof(FileHeader);
+    file_header.size = file_header.offset + dib.raw_size;
+
+    BMP_STAT_ADD(bytes_read, file_header.size);
+
+    loaded = true;
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::load_widen24(FILE *fptr, MemoryArena *arena)
+{
+    const uint32_t w = dib.width;
+    const uint32_t h = dib.height;
+
+    /* 24-bpp scanlines are padded to 4-byte boundaries in the file. */
+    const uint32_t file_pitch = (w * 3 + 3) & ~3U;
+
+    BMPError err = validate_payload(fptr, file_pitch);
+    if (err != BMP_SUCCESS)
+    {
+        return err;
+    }
+
+    err = alloc_pixels(w, h, arena);
+    if (err != BMP_SUCCESS)
+    {
+        return err;
+    }
+
+    if (fseek(fptr, file_header.offset, SEEK_SET) != 0)
+    {
+        return BMP_FILEERROR;
+    }
+
+    std::vector<uint8_t> line(file_pitch);
+
+    for (uint32_t y = 0; y < h; y++)
+    {
+        if (fread(line.data(), 1, file_pitch, fptr) != file_pitch)
+        {
+            return BMP_FILEERROR;
+        }
+
+        const ::Pixel::BGR24 *src = reinterpret_cast<const ::Pixel::BGR24*>(line.data());
+        Pixel *dst = scanline(file_line(y));
+        for (uint32_t i = 0; i < w; i++)
+        {
+            ::Pixel::convert(src[i], dst[i]);
+        }
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+template <typename OtherPixel>
+BMPError Bitmap<Pixel>::convert_to(Bitmap<OtherPixel> &out) const
+{
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (out.loaded)
+    {
+        return BMP_ALREADY_INIT;
+    }
+
+    const BMPError err = out.create_common(dib.width, dib.height, nullptr);
+    if (err != BMP_SUCCESS)
+    {
+        return err;
+    }
+
+    for (uint32_t y = 0; y < static_cast<uint32_t>(dib.height); y++)
+    {
+        const Pixel *src = scanline(y);
+        OtherPixel *dst = out.scanline(y);
+        for (uint32_t i = 0; i < static_cast<uint32_t>(dib.width); i++)
+        {
+            ::Pixel::convert(src[i], dst[i]);
+        }
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::decode_rle8(FILE *fptr, MemoryArena *arena)
+{
+    /* Palette follows the DIB header immediately; expand it to native pixels once. */
+    const uint32_t palette_n = (dib.n_colors != 0 && dib.n_colors <= 256) ? dib.n_colors : 256;
+    ColorTable table[256];
+    memset(table, 0, sizeof(table));
+
+    if (fseek(fptr, sizeof(FileHeader) + dib.size, SEEK_SET) != 0 ||
+        fread(table, sizeof(ColorTable), palette_n, fptr) != palette_n)
+    {
+        return BMP_INVALID_DIB;
+    }
+
+    Pixel lut[256];
+    for (uint32_t i = 0; i < 256; i++)
+    {
+        lut[i] = from_rgb(table[i].red_intensity, table[i].green_intensity,
+                          table[i].blue_intensity);
+    }
+
+    const BMPError err = alloc_pixels(dib.width, dib.height, arena);
+    if (err != BMP_SUCCESS)
+    {
+        return err;
+    }
+
+    /* Pixels an RLE stream skips over (deltas, early end) are defined as zero. */
+    memset(pixel_array, 0, row_stride * dib.height);
+
+    if (fseek(fptr, file_header.offset, SEEK_SET) != 0)
+    {
+        return BMP_FILEERROR;
+    }
+
+    const uint32_t w = dib.width;
+    const uint32_t h = dib.height;
+    uint32_t x = 0;
+    uint32_t y = 0;
+
+    for (;;)
+    {
+        int count = fgetc(fptr);
+        int value = fgetc(fptr);
+        if (count == EOF || value == EOF)
+        {
+            return BMP_FILEERROR;
+        }
+
+        if (count > 0)
+        {
+            /* Encoded mode: a run of `count` pixels of palette index `value`. */
+            if (y >= h || (x + count) > w)
+            {
+                return BMP_INVALID_DIB;
+            }
+
+            Pixel *dst = scanline(file_line(y)) + x;
+            for (int i = 0; i < count; i++)
+            {
+                dst[i] = lut[value];
+            }
+            x += count;
+        }
+        else if (value == 0)
+        {
+            /* Escape: end of line. */
+            x = 0;
+            y++;
+        }
+        else if (value == 1)
+        {
+            /* Escape: end of bitmap. */
+            return BMP_SUCCESS;
+        }
+        else if (value == 2)
+        {
+            /* Escape: delta move. */
+            const int dx = fgetc(fptr);
+            const int dy = fgetc(fptr);
+            if (dx == EOF || dy == EOF)
+            {
+                return BMP_FILEERROR;
+            }
+            x += dx;
+            y += dy;
+
+            /* A hostile stream of deltas could otherwise walk the cursor near
+             * UINT32_MAX and wrap the run-bound checks above into passing. */
+            if (x > w || y > h)
+            {
+                return BMP_INVALID_DIB;
+            }
+        }
+        else
+        {
+            /* Absolute mode: `value` literal palette indices, padded to even. */
+            if (y >= h || (x + value) > w)
+            {
+                return BMP_INVALID_DIB;
+            }
+
+            Pixel *dst = scanline(file_line(y)) + x;
+            for (int i = 0; i < value; i++)
+            {
+                const int idx = fgetc(fptr);
+                if (idx == EOF)
+                {
+                    return BMP_FILEERROR;
+                }
+                dst[i] = lut[idx];
+            }
+            x += value;
+
+            if ((value % 2) != 0 && fgetc(fptr) == EOF)
+            {
+                return BMP_FILEERROR;
+            }
+        }
+    }
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::decode_bitfields16(FILE *fptr, MemoryArena *arena)
+{
+    /* The three channel masks follow the DIB header immediately. */
+    uint32_t masks[3];
+    if (fseek(fptr, sizeof(FileHeader) + dib.size, SEEK_SET) != 0 ||
+        fread(masks, sizeof(uint32_t), 3, fptr) != 3)
+    {
+        return BMP_INVALID_DIB;
+    }
+
+    uint32_t shifts[3];
+    uint32_t bits[3];
+    for (int c = 0; c < 3; c++)
+    {
+        if (masks[c] == 0 || masks[c] > 0xFFFF)
+        {
+            return BMP_INVALID_DIB;
+        }
+
+        uint32_t m = masks[c];
+        shifts[c] = 0;
+        while ((m & 1) == 0)
+        {
+            m >>= 1;
+            shifts[c]++;
+        }
+        bits[c] = 0;
+        while (m & 1)
+        {
+            m >>= 1;
+            bits[c]++;
+        }
+        if (m != 0 || bits[c] > 8)
+        {
+            return BMP_INVALID_DIB;
+        }
+    }
+
+    /* Precompute each channel's expansion to 8 bits so the per-pixel loop is
+     * three masked lookups with no multiplies or divides. */
+    uint8_t expand[3][256];
+    for (int c = 0; c < 3; c++)
+    {
+        const uint32_t maxv = (1U << bits[c]) - 1;
+        for (uint32_t v = 0; v <= maxv; v++)
+        {
+            expand[c][v] = static_cast<uint8_t>((v * 255 + maxv / 2) / maxv);
+        }
+    }
+
+    const uint32_t w = dib.width;
+    const uint32_t h = dib.height;
+    /* 16bpp scanlines are padded to 4-byte boundaries in the file. */
+    const uint32_t file_pitch = (w * 2 + 3) & ~3U;
+
+    BMPError err = validate_payload(fptr, file_pitch);
+    if (err != BMP_SUCCESS)
+    {
+        return err;
+    }
+
+    err = alloc_pixels(dib.width, dib.height, arena);
+    if (err != BMP_SUCCESS)
+    {
+        return err;
+    }
+
+    if (fseek(fptr, file_header.offset, SEEK_SET) != 0)
+    {
+        return BMP_FILEERROR;
+    }
+
+    std::vector<uint16_t> line(file_pitch / 2);
+    for (uint32_t y = 0; y < h; y++)
+    {
+        if (fread(line.data(), 1, file_pitch, fptr) != file_pitch)
+        {
+            return BMP_FILEERROR;
+        }
+
+        Pixel *dst = scanline(file_line(y));
+        for (uint32_t i = 0; i < w; i++)
+        {
+            const uint16_t v = line[i];
+            dst[i] = from_rgb(expand[0][(v & masks[0]) >> shifts[0]],
+                              expand[1][(v & masks[1]) >> shifts[1]],
+                              expand[2][(v & masks[2]) >> shifts[2]]);
+        }
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::load(const char * const filename)
+{
+    return load_common(filename, nullptr);
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::load(const char * const filename, MemoryArena &arena)
+{
+    return load_common(filename, &arena);
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::load_region(const char * const filename,
+                                    const uint32_t row, const uint32_t col,
+                                    const uint32_t w, const uint32_t h)
+{
+    if (loaded)
+    {
+        return BMP_ALREADY_INIT;
+    }
+
+    FILE *fptr = fopen(filename, "rb");
+    if (!fptr)
+    {
+        return BMP_FILEERROR;
+    }
+
+    BMPError err = parse_headers(fptr);
+    if (err != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return err;
+    }
+
+    const BMPError fmt = check_native_format();
+    if (fmt != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return fmt;
+    }
+
+    err = validate_payload(fptr, disk_pitch(dib.width));
+    if (err != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return err;
+    }
+
+    if ((static_cast<uint64_t>(row) + h) > static_cast<uint64_t>(dib.height) ||
+        (static_cast<uint64_t>(col) + w) > static_cast<uint64_t>(dib.width) ||
+        w == 0 || h == 0)
+    {
+        fclose(fptr);
+        return BMP_OOB;
+    }
+
+    /* Source geometry needed for seeking, captured before the headers are
+     * rewritten to describe the window. @p file_line maps each wanted scanline
+     * to its file row, so a top-down source needs no special casing here. */
+    const uint64_t file_pitch = disk_pitch(dib.width);
+    const uint64_t base = file_header.offset + static_cast<uint64_t>(col) * sizeof(Pixel);
+
+    err = alloc_pixels(w, h, nullptr);
+    if (err != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return err;
+    }
+
+    for (uint32_t line = 0; line < h; line++)
+    {
+        if (fseek(fptr, base + static_cast<uint64_t>(file_line(row + line)) * file_pitch,
+                  SEEK_SET) != 0 ||
+            fread((void*)scanline(line),
+                  static_cast<uint64_t>(w) * sizeof(Pixel), 1, fptr) != 1)
+        {
+            fclose(fptr);
+            release_storage();
+            return BMP_FILEERROR;
+        }
+    }
+
+    fclose(fptr);
+
+    /* The instance is now a standalone w x h image, bottom-up like any other. */
+    top_down = false;
+    dib.width = w;
+    dib.height = h;
+    dib.raw_size = disk_pitch(w) * h;
+    file_header.offset = DIBHeaderType::BITMAPINFOHEADER + sizeof(FileHeader);
+    file_header.size = file_header.offset + dib.raw_size;
+
+    loaded = true;
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::open(const char * const filename)
+{
+    if (loaded || lazy_fp)
+    {
+        return BMP_ALREADY_INIT;
+    }
+
+    FILE *fptr = fopen(filename, "rb");
+    if (!fptr)
+    {
+        return BMP_FILEERROR;
+    }
+
+    const BMPError err = parse_headers(fptr);
+    if (err != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return err;
+    }
+
+    const BMPError fmt = check_native_format();
+    if (fmt != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return fmt;
+    }
+
+    const BMPError chk = validate_payload(fptr, disk_pitch(dib.width));
+    if (chk != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return chk;
+    }
+
+    lazy_fp = fptr;
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::ensure_pixels()
+{
+    if (loaded)
+    {
+        return BMP_SUCCESS;
+    }
+
+    if (!lazy_fp)
+    {
+        return BMP_NOTINIT;
+    }
+
+    BMPError err = alloc_pixels(dib.width, dib.height, nullptr);
+    if (err != BMP_SUCCESS)
+    {
+        return err;
+    }
+
+    err = read_pixels(lazy_fp);
+    if (err != BMP_SUCCESS)
+    {
+        release_storage();
+        return err;
+    }
+
+    fclose(lazy_fp);
+    lazy_fp = nullptr;
+    loaded = true;
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+std::future<BMPError> Bitmap<Pixel>::load_async(const char * const filename)
+{
+    /* The name is copied up front; the caller's buffer need not outlive the call. */
+    const std::string name(filename);
+    return std::async(std::launch::async,
+                      [this, name]() { return load(name.c_str()); });
+}
+
+template <typename Pixel>
+std::future<BMPError> Bitmap<Pixel>::write_async(const char * const filename)
+{
+    const std::string name(filename);
+    return std::async(std::launch::async,
+                      [this, name]() { return write(name.c_str()); });
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::load_mapped(const char * const filename)
+{
+    if (loaded)
+    {
+        return BMP_ALREADY_INIT;
+    }
+
+    FILE *fptr = fopen(filename, "rb");
+    if (!fptr)
+    {
+        return BMP_FILEERROR;
+    }
+
+    BMPError err = parse_headers(fptr);
+    if (err != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return err;
+    }
+
+    const BMPError fmt = check_native_format();
+    if (fmt != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return fmt;
+    }
+
+    /* A mapping exposes the file's rows in place; a top-down file's rows cannot
+     * be reordered without copying, which defeats the point of mapping. */
+    if (top_down)
+    {
+        fclose(fptr);
+        return BMP_UNSUPPORTED_FMT;
+    }
+
+    /* A short file would otherwise map fine and then SIGBUS on first touch of
+     * the missing pages; fail it up front instead. */
+    err = validate_payload(fptr, disk_pitch(dib.width));
+    if (err != BMP_SUCCESS)
+    {
+        fclose(fptr);
+        return err;
+    }
+
+    struct stat file_stat;
+    if (fstat(fileno(fptr), &file_stat) != 0)
+    {
+        fclose(fptr);
+        return BMP_FILEERROR;
+    }
+
+    /* A private mapping gives us lazy page-in for free, and copy-on-write
+     * promotion of only the pages set() actually dirties. */
+    void *base = mmap(nullptr, file_stat.st_size, PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE, fileno(fptr), 0);
+
+    /* The mapping holds its own reference to the file; the stream can go. */
+    fclose(fptr);
+
+    if (base == MAP_FAILED)
+    {
+        return BMP_OOM;
+    }
+
+    map_base = base;
+    map_size = file_stat.st_size;
+    pixel_array = reinterpret_cast<Pixel*>(static_cast<uint8_t*>(base) + file_header.offset);
+    ownership = OwnMapped;
+    n_pixels = static_cast<uint64_t>(dib.width) * dib.height;
+    /* The mapping exposes the file's own layout, so the stride is the file
+     * pitch regardless of the configured row alignment. */
+    row_stride = disk_pitch(dib.width);
+
+    loaded = true;
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::create_common(const uint64_t width, const uint64_t height,
+                                      MemoryArena *arena)
+{
+    if (loaded)
+    {
+        return BMP_ALREADY_INIT;
+    }
+
+    init_headers(width, height);
+
+    const BMPError err = alloc_pixels(width, height, arena);
+    if (err != BMP_SUCCESS)
+    {
+        return err;
+    }
+
+    memset(pixel_array, 0, row_stride * height);
+
+    loaded = true;
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::create(const uint64_t width, const uint64_t height)
+{
+    return create_common(width, height, nullptr);
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::create(const uint64_t width, const uint64_t height, MemoryArena &arena)
+{
+    return create_common(width, height, &arena);
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::create(const HeaderBlock &hdr)
+{
+    if (loaded)
+    {
+        return BMP_ALREADY_INIT;
+    }
+
+    if (!valid_header(hdr))
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    memcpy(&file_header, &hdr.file, sizeof(FileHeader));
+    memcpy(&dib, &hdr.info, DIBHeaderType::BITMAPINFOHEADER);
+
+    // Assuming dib.vres == dib.hres, as in parse_headers
+    dpi = dib.hres;
+
+    const BMPError err = alloc_pixels(dib.width, dib.height, nullptr);
+    if (err != BMP_SUCCESS)
+    {
+        return err;
+    }
+
+    loaded = true;
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::adopt(Pixel * const buffer, const uint64_t width,
+                              const uint64_t height, const bool take_ownership,
+                              const uint64_t stride_bytes)
+{
+    if (loaded)
+    {
+        return BMP_ALREADY_INIT;
+    }
+
+    if (!buffer || width == 0 || height == 0 ||
+        (stride_bytes != 0 && stride_bytes < width * sizeof(Pixel)))
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    init_headers(width, height);
+
+    pixel_array = buffer;
+    n_pixels = width * height;
+    row_stride = (stride_bytes != 0) ? stride_bytes : disk_pitch(width);
+    ownership = take_ownership ? OwnHeap : OwnExternal;
+
+    loaded = true;
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+Pixel *Bitmap<Pixel>::release()
+{
+    /* Mapped and arena storage is owned elsewhere; there is nothing to hand out.
+     * A lazily opened instance may not have materialized pixels at all yet. */
+    if (!loaded || (ownership != OwnHeap && ownership != OwnExternal))
+    {
+        return nullptr;
+    }
+
+    Pixel *buffer = pixel_array;
+
+    /* Drop our claim before reset() so release_storage does not delete[] it. */
+    ownership = OwnNone;
+    pixel_array = nullptr;
+    n_pixels = 0;
+    reset();
+
+    return buffer;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::write(const char * const filename)
+{
+    BMP_STAT_TIMER(write_ns);
+
+    if (!loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    const int fd = ::open(filename, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0)
+    {
+        return BMP_FILEERROR;
+    }
+
+    /* Assemble the 54-byte header block once, contiguously. */
+    uint8_t header_block[sizeof(FileHeader) + DIBHeaderType::BITMAPINFOHEADER];
+    memcpy(&header_block[0], &file_header, sizeof(FileHeader));
+    memcpy(&header_block[sizeof(FileHeader)], &dib, DIBHeaderType::BITMAPINFOHEADER);
+
+    if (top_down)
+    {
+        /* Re-emit the source's top-down orientation: a negative height in the
+         * header, with the rows going out in file (reverse memory) order. */
+        const int32_t neg_height = -dib.height;
+        memcpy(&header_block[sizeof(FileHeader) + offsetof(BitmapInfoHeader, height)],
+               &neg_height, sizeof(neg_height));
+    }
+
+    const uint64_t pitch = disk_pitch(dib.width);
+    const uint64_t payload = static_cast<uint64_t>(dib.width) * sizeof(Pixel);
+
+    BMP_STAT_ADD(bytes_written, sizeof(header_block) + pitch * dib.height);
+
+    if (row_stride == pitch && !top_down)
+    {
+        /* In-memory scanlines already carry the file's 4-byte row padding, so the
+         * headers and the whole pixel block go down in one writev call. */
+        struct iovec iov[2];
+        iov[0].iov_base = header_block;
+        iov[0].iov_len = sizeof(header_block);
+        iov[1].iov_base = pixel_array;
+        iov[1].iov_len = pitch * dib.height;
+
+        if (writev_full(fd, iov, 2) != BMP_SUCCESS)
+        {
+            ::close(fd);
+            return BMP_FILEERROR;
+        }
+    }
+    else
+    {
+        /* Wider in-memory strides are trimmed back to the file pitch scanline by
+         * scanline (and a top-down file's rows emitted in reverse), batching rows
+         * per writev to stay under IOV_MAX. */
+        const uint8_t pad_bytes[sizeof(uint32_t)] = {0, 0, 0, 0};
+        const uint64_t pad_len = pitch - payload;
+
+        /* Worst case per batch is the header block plus payload + pad segments
+         * for every row: 1 + 511 * 2 = 1023, under the 1024-segment IOV_MAX. */
+        const uint32_t batch_rows = 511;
+        struct iovec iov[1 + 2 * batch_rows];
+
+        const uint32_t h = dib.height;
+        uint32_t y = 0;
+        bool headers_pending = true;
+        while (y < h || headers_pending)
+        {
+            int n = 0;
+            if (headers_pending)
+            {
+                iov[n].iov_base = header_block;
+                iov[n].iov_len = sizeof(header_block);
+                n++;
+                headers_pending = false;
+            }
+
+            const uint32_t stop = ((h - y) < batch_rows) ? h : (y + batch_rows);
+            for (; y < stop; y++)
+            {
+                iov[n].iov_base = scanline(file_line(y));
+                iov[n].iov_len = payload;
+                n++;
+                if (pad_len > 0)
+                {
+                    iov[n].iov_base = const_cast<uint8_t*>(pad_bytes);
+                    iov[n].iov_len = pad_len;
+                    n++;
+                }
+            }
+
+            if (writev_full(fd, iov, n) != BMP_SUCCESS)
+            {
+                ::close(fd);
+                return BMP_FILEERROR;
+            }
+        }
+    }
+
+    ::close(fd);
+
+    /* The file now matches memory in full. */
+    dirty_min = UINT32_MAX;
+    dirty_max = 0;
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::write_incremental(const char * const filename)
+{
+    if (!loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (!dirty_tracking)
+    {
+        return write(filename);
+    }
+
+    /* Past the full-write fallthrough, so write_ns is not counted twice. */
+    BMP_STAT_TIMER(write_ns);
+
+    if (dirty_min == UINT32_MAX)
+    {
+        /* Nothing has changed since the last write. */
+        return BMP_SUCCESS;
+    }
+
+    FILE *fptr = fopen(filename, "rb+");
+    if (!fptr)
+    {
+        return BMP_FILEERROR;
+    }
+
+    /* The target must be a prior write of this same image geometry. */
+    FileHeader existing;
+    if (fread(&existing, sizeof(existing), 1, fptr) != 1 ||
+        existing.header_type != HeaderType::BM ||
+        existing.size != file_header.size ||
+        existing.offset != file_header.offset)
+    {
+        fclose(fptr);
+        return BMP_BAD_INPUT;
+    }
+
+    const uint64_t pitch = disk_pitch(dib.width);
+    const uint64_t payload = static_cast<uint64_t>(dib.width) * sizeof(Pixel);
+    const uint32_t n_rows = dirty_max - dirty_min + 1;
+
+    if (row_stride == pitch && !top_down)
+    {
+        /* Memory rows carry the file's padding: one seek, one contiguous write. */
+        if (fseek(fptr, file_header.offset + static_cast<uint64_t>(dirty_min) * pitch,
+                  SEEK_SET) != 0 ||
+            fwrite((void*)scanline(dirty_min), pitch, n_rows, fptr) != n_rows)
+        {
+            fclose(fptr);
+            return BMP_FILEERROR;
+        }
+    }
+    else
+    {
+        /* Row by row: each scanline's payload lands at its file row (reversed for
+         * a top-down file); padding bytes already in the file are left untouched. */
+        for (uint32_t line = dirty_min; line <= dirty_max; line++)
+        {
+            if (fseek(fptr,
+                      file_header.offset + static_cast<uint64_t>(file_line(line)) * pitch,
+                      SEEK_SET) != 0 ||
+                fwrite((void*)scanline(line), payload, 1, fptr) != 1)
+            {
+                fclose(fptr);
+                return BMP_FILEERROR;
+            }
+        }
+    }
+
+    fclose(fptr);
+
+    BMP_STAT_ADD(bytes_written,
+                 ((row_stride == pitch && !top_down) ? pitch : payload) * n_rows);
+
+    dirty_min = UINT32_MAX;
+    dirty_max = 0;
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::get(const uint32_t row, const uint32_t col, Pixel &pixel) const
+{
+    BMP_STAT_ADD(get_calls, 1);
+
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
+
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (row >= static_cast<uint32_t>(dib.width) || col >= static_cast<uint32_t>(dib.height))
+    {
+        BMP_STAT_ADD(oob_failures, 1);
+        return BMP_OOB;
+    }
+
+    memcpy(&pixel, scanline(col) + row, sizeof(pixel));
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::set(const uint64_t row, const uint64_t col, Pixel &pixel)
+{
+    BMP_STAT_ADD(set_calls, 1);
+
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
+
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
+
+    if (row >= static_cast<uint64_t>(dib.width) || col >= static_cast<uint64_t>(dib.height))
+    {
+        BMP_STAT_ADD(oob_failures, 1);
+        return BMP_OOB;
+    }
+
+    const uint32_t line = static_cast<uint32_t>(col);
+    std::unique_lock<std::mutex> guard = line_guard(line);
+
+    memcpy(scanline(line) + row, &pixel, sizeof(pixel));
+
+    if (dirty_tracking)
+    {
+        mark_dirty(line, line);
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::get_row(const uint32_t row, Pixel *dst, const uint64_t count) const
+{
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
+
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (!dst)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    if (row >= static_cast<uint32_t>(dib.height) || count > static_cast<uint64_t>(dib.width))
+    {
+        return BMP_OOB;
+    }
+
+    memcpy(dst, scanline(row), count * sizeof(Pixel));
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::set_row(const uint32_t row, const Pixel *src, const uint64_t count)
+{
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
+
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (!src)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
+
+    if (row >= static_cast<uint32_t>(dib.height) || count > static_cast<uint64_t>(dib.width))
+    {
+        return BMP_OOB;
+    }
+
+    std::unique_lock<std::mutex> guard = line_guard(row);
+
+    memcpy(scanline(row), src, count * sizeof(Pixel));
+
+    mark_dirty(row, row);
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::get_rect(const uint32_t row, const uint32_t col,
+                                 const uint32_t w, const uint32_t h, Pixel *dst) const
+{
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
+
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (!dst)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    if ((static_cast<uint64_t>(row) + h) > static_cast<uint64_t>(dib.height) ||
+        (static_cast<uint64_t>(col) + w) > static_cast<uint64_t>(dib.width))
+    {
+        return BMP_OOB;
+    }
+
+    if (col == 0 && w == static_cast<uint32_t>(dib.width) &&
+        row_stride == static_cast<uint64_t>(w) * sizeof(Pixel))
+    {
+        /* Full-width window with no inter-row padding: the scanlines are contiguous. */
+        memcpy(dst, scanline(row), static_cast<uint64_t>(w) * h * sizeof(Pixel));
+        return BMP_SUCCESS;
+    }
+
+    for (uint32_t line = 0; line < h; line++)
+    {
+        memcpy(&dst[static_cast<uint64_t>(line) * w],
+               scanline(row + line) + col,
+               static_cast<uint64_t>(w) * sizeof(Pixel));
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::set_rect(const uint32_t row, const uint32_t col,
+                                 const uint32_t w, const uint32_t h, const Pixel *src)
+{
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
+
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (!src)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
+
+    if ((static_cast<uint64_t>(row) + h) > static_cast<uint64_t>(dib.height) ||
+        (static_cast<uint64_t>(col) + w) > static_cast<uint64_t>(dib.width))
+    {
+        return BMP_OOB;
+    }
+
+    mark_dirty(row, (h > 0) ? (row + h - 1) : row);
+
+    if (!shard_locks && col == 0 && w == static_cast<uint32_t>(dib.width) &&
+        row_stride == static_cast<uint64_t>(w) * sizeof(Pixel))
+    {
+        /* Full-width window with no inter-row padding: the scanlines are contiguous. */
+        memcpy(scanline(row), src, static_cast<uint64_t>(w) * h * sizeof(Pixel));
+        return BMP_SUCCESS;
+    }
+
+    /* One shard lock held at a time, in ascending line order: no nesting, no
+     * deadlock against other writers walking their own rectangles. */
+    for (uint32_t line = 0; line < h; line++)
+    {
+        std::unique_lock<std::mutex> guard = line_guard(row + line);
+        memcpy(scanline(row + line) + col,
+               &src[static_cast<uint64_t>(line) * w],
+               static_cast<uint64_t>(w) * sizeof(Pixel));
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+Pixel *Bitmap<Pixel>::row_ptr(const uint32_t row)
+{
+    if (fault_in() != BMP_SUCCESS)
+    {
+        return nullptr;
+    }
+
+    /* A frozen image hands out no mutable aliases. */
+    if (!pixel_array || !loaded || frozen || row >= static_cast<uint32_t>(dib.height))
+    {
+        return nullptr;
+    }
+
+    return scanline(row);
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::view(const uint32_t row, const uint32_t col,
+                             const uint32_t w, const uint32_t h, BitmapView<Pixel> &out)
+{
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    /* A view is a mutable alias; a frozen image refuses to produce one. */
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
+
+    if ((static_cast<uint64_t>(row) + h) > static_cast<uint64_t>(dib.height) ||
+        (static_cast<uint64_t>(col) + w) > static_cast<uint64_t>(dib.width))
+    {
+        return BMP_OOB;
+    }
+
+    out = BitmapView<Pixel>(scanline(row) + col, w, h, row_stride);
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::fill(const Pixel &pixel)
+{
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
+
+    const uint64_t w = dib.width;
+    if (w == 0 || dib.height == 0)
+    {
+        return BMP_SUCCESS;
+    }
+
+    mark_dirty(0, static_cast<uint32_t>(dib.height) - 1);
+
+    /* Build scanline 0 by doubling its initialized prefix, then stamp it
+     * across the remaining lines. */
+    Pixel *first = scanline(0);
+    memcpy(&first[0], &pixel, sizeof(Pixel));
+    for (uint64_t filled = 1; filled < w; )
+    {
+        const uint64_t n = (filled < (w - filled)) ? filled : (w - filled);
+        memcpy(&first[filled], &first[0], n * sizeof(Pixel));
+        filled += n;
+    }
+
+    for (uint32_t line = 1; line < static_cast<uint32_t>(dib.height); line++)
+    {
+        memcpy(scanline(line), first, w * sizeof(Pixel));
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::fill_rect(const uint32_t row, const uint32_t col,
+                                  const uint32_t w, const uint32_t h, const Pixel &pixel)
+{
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
+
+    if ((static_cast<uint64_t>(row) + h) > static_cast<uint64_t>(dib.height) ||
+        (static_cast<uint64_t>(col) + w) > static_cast<uint64_t>(dib.width))
+    {
+        return BMP_OOB;
+    }
+
+    if (w == 0 || h == 0)
+    {
+        return BMP_SUCCESS;
+    }
+
+    mark_dirty(row, row + h - 1);
+
+    /* Build the first segment by doubling, then stamp it across the other lines.
+     * With shared writes on, each line's shard lock is taken one at a time in
+     * ascending order, matching set_rect. */
+    Pixel *first = scanline(row) + col;
+    {
+        std::unique_lock<std::mutex> guard = line_guard(row);
+        memcpy(&first[0], &pixel, sizeof(Pixel));
+        for (uint64_t filled = 1; filled < w; )
+        {
+            const uint64_t n = (filled < (w - filled)) ? filled : (w - filled);
+            memcpy(&first[filled], &first[0], n * sizeof(Pixel));
+            filled += n;
+        }
+    }
+
+    for (uint32_t line = 1; line < h; line++)
+    {
+        std::unique_lock<std::mutex> guard = line_guard(row + line);
+        memcpy(scanline(row + line) + col, first, static_cast<uint64_t>(w) * sizeof(Pixel));
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::set_channel(const ::Pixel::Channel channel, const uint8_t value)
+{
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
+
+    if (channel >= sizeof(Pixel))
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    mark_dirty(0, static_cast<uint32_t>(dib.height) - 1);
+
+    /* Padded strides process one scanline per segment; the default layout's rows
+     * are contiguous and run as one whole-image segment. */
+    const bool contiguous = (row_stride == static_cast<uint64_t>(dib.width) * sizeof(Pixel));
+    const uint32_t segments = contiguous ? 1 : static_cast<uint32_t>(dib.height);
+    const uint64_t seg_pixels = contiguous ? pixel_max() : dib.width;
+
+    for (uint32_t s = 0; s < segments; s++)
+    {
+        uint8_t *bytes = reinterpret_cast<uint8_t*>(contiguous ? pixel_array : scanline(s));
+        const uint64_t total_bytes = seg_pixels * sizeof(Pixel);
+        uint64_t i = channel;
+
+#if defined(__SSE2__)
+        if (sizeof(Pixel) == 4)
+        {
+            const uint32_t lane_value = static_cast<uint32_t>(value) << (8 * channel);
+            const uint32_t lane_keep = ~(UINT32_C(0xFF) << (8 * channel));
+            const __m128i vvalue = _mm_set1_epi32(lane_value);
+            const __m128i vkeep = _mm_set1_epi32(lane_keep);
+
+            uint64_t b = 0;
+            for (; (b + 16) <= total_bytes; b += 16)
+            {
+                __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&bytes[b]));
+                v = _mm_or_si128(_mm_and_si128(v, vkeep), vvalue);
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&bytes[b]), v);
+            }
+            i = b + channel;
+        }
+#endif
+
+        for (; i < total_bytes; i += sizeof(Pixel))
+        {
+            bytes[i] = value;
+        }
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::blend(const Bitmap &other, const uint8_t alpha)
+{
+    if (!pixel_array || !loaded || !other.pixel_array || !other.loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
+
+    if (other.dib.width != dib.width || other.dib.height != dib.height)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    mark_dirty(0, static_cast<uint32_t>(dib.height) - 1);
+
+    /* Both images must be row-contiguous for the single whole-image segment;
+     * otherwise each scanline pair is blended on its own. */
+    const uint64_t packed = static_cast<uint64_t>(dib.width) * sizeof(Pixel);
+    const bool contiguous = (row_stride == packed && other.row_stride == packed);
+    const uint32_t segments = contiguous ? 1 : static_cast<uint32_t>(dib.height);
+    const uint64_t seg_pixels = contiguous ? pixel_max() : dib.width;
+    const uint16_t inv = 255 - alpha;
+
+    for (uint32_t seg = 0; seg < segments; seg++)
+    {
+        uint8_t *dst = reinterpret_cast<uint8_t*>(contiguous ? pixel_array : scanline(seg));
+        const uint8_t *src = reinterpret_cast<const uint8_t*>(
+            contiguous ? other.pixel_array : other.scanline(seg));
+        const uint64_t total_bytes = seg_pixels * sizeof(Pixel);
+        uint64_t i = 0;
+
+#if defined(__SSE2__)
+        {
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i valpha = _mm_set1_epi16(alpha);
+            const __m128i vinv = _mm_set1_epi16(inv);
+            const __m128i round = _mm_set1_epi16(128);
+
+            for (; (i + 16) <= total_bytes; i += 16)
+            {
+                const __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&dst[i]));
+                const __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&src[i]));
+
+                /* Widen to 16-bit, weigh, and divide by 255 exactly:
+                 * t = d*inv + s*alpha + 128; out = (t + (t >> 8)) >> 8 */
+                __m128i lo = _mm_add_epi16(
+                    _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), vinv),
+                                  _mm_mullo_epi16(_mm_unpacklo_epi8(s, zero), valpha)),
+                    round);
+                __m128i hi = _mm_add_epi16(
+                    _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), vinv),
+                                  _mm_mullo_epi16(_mm_unpackhi_epi8(s, zero), valpha)),
+                    round);
+                lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+                hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(&dst[i]),
+                                 _mm_packus_epi16(lo, hi));
+            }
+        }
+#endif
+
+        for (; i < total_bytes; i++)
+        {
+            const uint16_t t = dst[i] * inv + src[i] * alpha + 128;
+            dst[i] = (t + (t >> 8)) >> 8;
+        }
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::grayscale()
+{
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
+
+    mark_dirty(0, static_cast<uint32_t>(dib.height) - 1);
+
+    for (uint32_t y = 0; y < static_cast<uint32_t>(dib.height); y++)
+    {
+        Pixel *line = scanline(y);
+        for (uint32_t i = 0; i < static_cast<uint32_t>(dib.width); i++)
+        {
+            Pixel &p = line[i];
+            const uint8_t luma = (77 * p.r + 150 * p.g + 29 * p.b) >> 8;
+            p.b = luma;
+            p.g = luma;
+            p.r = luma;
+        }
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::histogram(uint32_t bins[3][256]) const
+{
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
+
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (!bins)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    /* Four independent sub-histogram sets: pixel i updates set i % 4, so back-to-back
+     * increments of the same bin land on different counters and the serializing
+     * store-to-load forward between iterations disappears. */
+    static const uint32_t SUBS = 4;
+    uint32_t sub[SUBS][3][256];
+    memset(sub, 0, sizeof(sub));
+
+    /* Padded strides walk one scanline per segment; the default layout's rows
+     * are contiguous and count as one whole-image segment. */
+    const bool contiguous = (row_stride == static_cast<uint64_t>(dib.width) * sizeof(Pixel));
+    const uint32_t segments = contiguous ? 1 : static_cast<uint32_t>(dib.height);
+    const uint64_t seg_pixels = contiguous ? pixel_max() : dib.width;
+    const uint64_t step = sizeof(Pixel);
+
+    for (uint32_t seg = 0; seg < segments; seg++)
+    {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t*>(
+            contiguous ? pixel_array : scanline(seg));
+        uint64_t i = 0;
+
+        for (; (i + SUBS) <= seg_pixels; i += SUBS)
+        {
+            const uint8_t *p0 = &bytes[(i + 0) * step];
+            const uint8_t *p1 = &bytes[(i + 1) * step];
+            const uint8_t *p2 = &bytes[(i + 2) * step];
+            const uint8_t *p3 = &bytes[(i + 3) * step];
+
+            sub[0][0][p0[0]]++; sub[0][1][p0[1]]++; sub[0][2][p0[2]]++;
+            sub[1][0][p1[0]]++; sub[1][1][p1[1]]++; sub[1][2][p1[2]]++;
+            sub[2][0][p2[0]]++; sub[2][1][p2[1]]++; sub[2][2][p2[2]]++;
+            sub[3][0][p3[0]]++; sub[3][1][p3[1]]++; sub[3][2][p3[2]]++;
+        }
+
+        for (; i < seg_pixels; i++)
+        {
+            const uint8_t *p = &bytes[i * step];
+            sub[0][0][p[0]]++;
+            sub[0][1][p[1]]++;
+            sub[0][2][p[2]]++;
+        }
+    }
+
+    for (uint32_t c = 0; c < 3; c++)
+    {
+        for (uint32_t v = 0; v < 256; v++)
+        {
+            bins[c][v] = sub[0][c][v] + sub[1][c][v] + sub[2][c][v] + sub[3][c][v];
+        }
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::channel_minmax(uint8_t mins[3], uint8_t maxs[3]) const
+{
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
+
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (!mins || !maxs)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    mins[0] = mins[1] = mins[2] = 0xFF;
+    maxs[0] = maxs[1] = maxs[2] = 0;
+
+    const bool contiguous = (row_stride == static_cast<uint64_t>(dib.width) * sizeof(Pixel));
+    const uint32_t segments = contiguous ? 1 : static_cast<uint32_t>(dib.height);
+    const uint64_t seg_pixels = contiguous ? pixel_max() : dib.width;
+
+    for (uint32_t seg = 0; seg < segments; seg++)
+    {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t*>(
+            contiguous ? pixel_array : scanline(seg));
+        uint64_t i = 0;
+
+#if defined(__SSE2__)
+        if (sizeof(Pixel) == 4 && seg_pixels >= 4)
+        {
+            /* Channels repeat every 4 bytes, so lane j of a 16-byte register always
+             * holds channel j % 4 and vector byte min/max reduces 4 pixels a step. */
+            __m128i vmin = _mm_set1_epi8(static_cast<char>(0xFF));
+            __m128i vmax = _mm_setzero_si128();
+
+            const uint64_t total_bytes = seg_pixels * 4;
+            uint64_t b = 0;
+            for (; (b + 16) <= total_bytes; b += 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&bytes[b]));
+                vmin = _mm_min_epu8(vmin, v);
+                vmax = _mm_max_epu8(vmax, v);
+            }
+
+            uint8_t lane_min[16], lane_max[16];
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lane_min), vmin);
+            _mm_storeu_si128(reinterpret_cast<__m128i*>(lane_max), vmax);
+            for (uint32_t lane = 0; lane < 16; lane++)
+            {
+                const uint32_t c = lane % 4;
+                if (c < 3)
+                {
+                    if (lane_min[lane] < mins[c]) { mins[c] = lane_min[lane]; }
+                    if (lane_max[lane] > maxs[c]) { maxs[c] = lane_max[lane]; }
+                }
+            }
+
+            i = b / 4;
+        }
+#endif
+
+        for (; i < seg_pixels; i++)
+        {
+            const uint8_t *p = &bytes[i * sizeof(Pixel)];
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                if (p[c] < mins[c]) { mins[c] = p[c]; }
+                if (p[c] > maxs[c]) { maxs[c] = p[c]; }
+            }
+        }
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::mean(double out[3]) const
+{
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
+
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (!out)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    const uint64_t total = pixel_max();
+    uint64_t sums[3] = {0, 0, 0};
+
+    const bool contiguous = (row_stride == static_cast<uint64_t>(dib.width) * sizeof(Pixel));
+    const uint32_t segments = contiguous ? 1 : static_cast<uint32_t>(dib.height);
+    const uint64_t seg_pixels = contiguous ? total : dib.width;
+
+    for (uint32_t seg = 0; seg < segments; seg++)
+    {
+        const uint8_t *bytes = reinterpret_cast<const uint8_t*>(
+            contiguous ? pixel_array : scanline(seg));
+        uint64_t i = 0;
+
+#if defined(__SSE2__)
+        if (sizeof(Pixel) == 4 && seg_pixels >= 4)
+        {
+            /* Mask one channel's bytes out of the 16-byte load and let SAD-against-zero
+             * sum them horizontally; one load feeds all three channel accumulators. */
+            const __m128i zero = _mm_setzero_si128();
+            const __m128i masks[3] = {
+                _mm_set1_epi32(0x000000FF),
+                _mm_set1_epi32(0x0000FF00),
+                _mm_set1_epi32(0x00FF0000),
+            };
+            __m128i acc[3] = {zero, zero, zero};
+
+            const uint64_t total_bytes = seg_pixels * 4;
+            uint64_t b = 0;
+            for (; (b + 16) <= total_bytes; b += 16)
+            {
+                const __m128i v = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&bytes[b]));
+                for (uint32_t c = 0; c < 3; c++)
+                {
+                    acc[c] = _mm_add_epi64(acc[c],
+                                           _mm_sad_epu8(_mm_and_si128(v, masks[c]), zero));
+                }
+            }
+
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                uint64_t lanes[2];
+                _mm_storeu_si128(reinterpret_cast<__m128i*>(lanes), acc[c]);
+                sums[c] += lanes[0] + lanes[1];
+            }
+
+            i = b / 4;
+        }
+#endif
+
+        for (; i < seg_pixels; i++)
+        {
+            const uint8_t *p = &bytes[i * sizeof(Pixel)];
+            sums[0] += p[0];
+            sums[1] += p[1];
+            sums[2] += p[2];
+        }
+    }
+
+    for (uint32_t c = 0; c < 3; c++)
+    {
+        out[c] = (total > 0) ? (static_cast<double>(sums[c]) / total) : 0.0;
+    }
+
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::equals(const Bitmap &other, bool &same) const
+{
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
+
+    const BMPError other_fault = other.fault_in();
+    if (other_fault != BMP_SUCCESS)
+    {
+        return other_fault;
+    }
+
+    if (!pixel_array || !loaded || !other.pixel_array || !other.loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (other.dib.width != dib.width || other.dib.height != dib.height)
+    {
+        same = false;
+        return BMP_SUCCESS;
+    }
+
+    const uint64_t payload = static_cast<uint64_t>(dib.width) * sizeof(Pixel);
+    for (uint32_t y = 0; y < static_cast<uint32_t>(dib.height); y++)
+    {
+        if (memcmp(scanline(y), other.scanline(y), payload) != 0)
+        {
+            same = false;
+            return BMP_SUCCESS;
+        }
+    }
+
+    same = true;
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::diff_count(const Bitmap &other, const uint8_t tolerance,
+                                   uint64_t &count) const
+{
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
+    {
+        return fault;
+    }
 
-protected:
-    /*!
-     * @inline pixel_index
-     * @brief Get the 1-Dimensional array offset of @p pixel_array from 2-Dimensional coordinates.
-     *
-     * @param[in] row The row coordinate.
-     * @param[in] col The column coordinate.
-     *
-     * @return The 2D --> 1D pixel map.
-     */
-    inline uint64_t pixel_index(const int32_t row, const int32_t col) const 
-    { 
-        return row + (col * dib.width); 
+    const BMPError other_fault = other.fault_in();
+    if (other_fault != BMP_SUCCESS)
+    {
+        return other_fault;
     }
 
-    /*!
-     * @inline pixel_max
-     * @brief Get the max number of the pixel data array.
-     *
-     * @return The number of pixels.
-     */
-    inline uint64_t pixel_max() const 
-    { 
-        return dib.width * dib.height; 
+    if (!pixel_array || !loaded || !other.pixel_array || !other.loaded)
+    {
+        return BMP_NOTINIT;
     }
-    
-    /*!
-     * @var pixel_array
-     * @brief A pointer to the internal pixel data of the Bitmap image.
-     */
-    Pixel *pixel_array;
 
-    /*!
-     * @var loaded
-     * @brief A flag to indicate that a Bitmap image has been loaded by this instance.
-     */
-    bool loaded;
+    if (other.dib.width != dib.width || other.dib.height != dib.height)
+    {
+        return BMP_BAD_INPUT;
+    }
 
-private:
-    /*!
-     * @var dib
-     * @brief The Device Independent header for this Bitmap image.
-     */
-    BitmapInfoHeader dib;
-    
-    /*!
-     * @var file_header
-     * @brief The file header for this Bitmap image.
-     */
-    FileHeader file_header;
+    count = 0;
 
-    /*!
-     * @var dpi
-     * @brief Dots per inch setting for this instance.
-     */
-    uint32_t dpi;
-}; /* class Bitmap<> */
+    const uint32_t w = dib.width;
+    for (uint32_t y = 0; y < static_cast<uint32_t>(dib.height); y++)
+    {
+        const uint8_t *a = reinterpret_cast<const uint8_t*>(scanline(y));
+        const uint8_t *b = reinterpret_cast<const uint8_t*>(other.scanline(y));
+        uint32_t i = 0;
 
-/* Templated Base Class Definitions */
+#if defined(__SSE2__)
+        if (sizeof(Pixel) == 4)
+        {
+            /* |a-b| via two saturating subtractions; a byte exceeds the tolerance
+             * exactly when subtracting it saturates to nonzero. The alpha lane is
+             * masked out so only the three color channels count. */
+            const __m128i vtol = _mm_set1_epi8(static_cast<char>(tolerance));
+            const __m128i color = _mm_set1_epi32(0x00FFFFFF);
+            const __m128i zero = _mm_setzero_si128();
+
+            const uint32_t row_bytes = w * 4;
+            uint32_t byte = 0;
+            for (; (byte + 16) <= row_bytes; byte += 16)
+            {
+                const __m128i va = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&a[byte]));
+                const __m128i vb = _mm_loadu_si128(reinterpret_cast<const __m128i*>(&b[byte]));
+                const __m128i diff = _mm_or_si128(_mm_subs_epu8(va, vb),
+                                                  _mm_subs_epu8(vb, va));
+                const __m128i exceeds = _mm_andnot_si128(
+                    _mm_cmpeq_epi8(_mm_subs_epu8(diff, vtol), zero), color);
+
+                /* One mask bit per exceeding byte; any bit in a pixel's nibble -> changed. */
+                int mask = (~_mm_movemask_epi8(_mm_cmpeq_epi8(exceeds, zero))) & 0xFFFF;
+                while (mask != 0)
+                {
+                    count++;
+                    mask &= ~(0xF << ((__builtin_ctz(mask) / 4) * 4));
+                }
+            }
+            i = byte / 4;
+        }
+#endif
+
+        for (; i < w; i++)
+        {
+            const uint8_t *pa = &a[i * sizeof(Pixel)];
+            const uint8_t *pb = &b[i * sizeof(Pixel)];
+            for (uint32_t c = 0; c < 3; c++)
+            {
+                const uint8_t d = (pa[c] > pb[c]) ? (pa[c] - pb[c]) : (pb[c] - pa[c]);
+                if (d > tolerance)
+                {
+                    count++;
+                    break;
+                }
+            }
+        }
+    }
+
+    return BMP_SUCCESS;
+}
 
 template <typename Pixel>
-Bitmap<Pixel>::~Bitmap()
+BMPError Bitmap<Pixel>::diff_bounding_box(const Bitmap &other, uint32_t &row, uint32_t &col,
+                                          uint32_t &w, uint32_t &h) const
 {
-    if (pixel_array)
+    const BMPError fault = fault_in();
+    if (fault != BMP_SUCCESS)
     {
-        delete[] pixel_array;
-        pixel_array = nullptr;
+        return fault;
     }
 
-    memset(&dib, 0, sizeof(dib));
-    memset(&file_header, 0, sizeof(file_header));
+    const BMPError other_fault = other.fault_in();
+    if (other_fault != BMP_SUCCESS)
+    {
+        return other_fault;
+    }
 
-    loaded = false;
+    if (!pixel_array || !loaded || !other.pixel_array || !other.loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (other.dib.width != dib.width || other.dib.height != dib.height)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    const uint32_t width = dib.width;
+    const uint64_t payload = static_cast<uint64_t>(width) * sizeof(Pixel);
+
+    uint32_t min_x = width;
+    uint32_t max_x = 0;
+    uint32_t min_y = UINT32_MAX;
+    uint32_t max_y = 0;
+
+    for (uint32_t y = 0; y < static_cast<uint32_t>(dib.height); y++)
+    {
+        const Pixel *a = scanline(y);
+        const Pixel *b = other.scanline(y);
+
+        /* Identical scanlines are dismissed with one compare. */
+        if (memcmp(a, b, payload) == 0)
+        {
+            continue;
+        }
+
+        if (min_y == UINT32_MAX)
+        {
+            min_y = y;
+        }
+        max_y = y;
+
+        /* Tighten the horizontal extent only over the already-covered span's
+         * outside; pixels between min_x and max_x cannot widen the box. */
+        for (uint32_t x = 0; x < min_x; x++)
+        {
+            if (memcmp(&a[x], &b[x], sizeof(Pixel)) != 0)
+            {
+                min_x = x;
+                break;
+            }
+        }
+        for (uint32_t x = width; x > max_x + 1; x--)
+        {
+            if (memcmp(&a[x - 1], &b[x - 1], sizeof(Pixel)) != 0)
+            {
+                max_x = x - 1;
+                break;
+            }
+        }
+    }
+
+    if (min_y == UINT32_MAX)
+    {
+        row = 0;
+        col = 0;
+        w = 0;
+        h = 0;
+        return BMP_SUCCESS;
+    }
+
+    row = min_y;
+    col = min_x;
+    w = max_x - min_x + 1;
+    h = max_y - min_y + 1;
+    return BMP_SUCCESS;
 }
 
 template <typename Pixel>
-BMPError Bitmap<Pixel>::load(const char * const filename)
+BMPError Bitmap<Pixel>::resize(const uint32_t new_w, const uint32_t new_h,
+                               const Filter filter, Bitmap &out) const
 {
-    if (loaded)
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (new_w == 0 || new_h == 0)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    if (out.loaded)
     {
         return BMP_ALREADY_INIT;
     }
 
-    FILE *fptr = fopen(filename, "rb");
-    if (!fptr)
+    const BMPError err = out.create_common(new_w, new_h, nullptr);
+    if (err != BMP_SUCCESS)
     {
-        return BMP_FILEERROR;
+        return err;
     }
-    fread(&file_header, sizeof(file_header), 1, fptr);
 
-    if (file_header.header_type != Bitmap::HeaderType::BM)
+    const uint32_t w = dib.width;
+    const uint32_t h = dib.height;
+    const uint32_t ch = sizeof(Pixel);
+
+    if (filter == Filter::Nearest)
     {
-        return BMP_INVALID_HDR;
+        for (uint32_t j = 0; j < new_h; j++)
+        {
+            const uint32_t sy = (static_cast<uint64_t>(2 * j + 1) * h) / (2 * new_h);
+            const Pixel *src = scanline(sy);
+            Pixel *dst = out.scanline(j);
+            for (uint32_t i = 0; i < new_w; i++)
+            {
+                const uint32_t sx = (static_cast<uint64_t>(2 * i + 1) * w) / (2 * new_w);
+                dst[i] = src[sx];
+            }
+        }
+
+        return BMP_SUCCESS;
     }
 
-    fread((void*)&dib, DIBHeaderType::BITMAPINFOHEADER, 1, fptr);
-    if (dib.size != DIBHeaderType::BITMAPINFOHEADER)
+    std::vector<uint32_t> x_start;
+    std::vector<int32_t> x_weight;
+    uint32_t x_taps = 0;
+    build_taps(w, new_w, filter, x_start, x_weight, x_taps);
+
+    std::vector<uint32_t> y_start;
+    std::vector<int32_t> y_weight;
+    uint32_t y_taps = 0;
+    build_taps(h, new_h, filter, y_start, y_weight, y_taps);
+
+    /* Horizontal pass: (w x h) -> (new_w x h), channel bytes accumulated in fixed
+     * point with the rounding constant folded in. */
+    const int32_t round = 1 << (RESAMPLE_FRAC_BITS - 1);
+    std::vector<uint8_t> mid(static_cast<size_t>(new_w) * h * ch);
+
+    for (uint32_t y = 0; y < h; y++)
     {
-        return BMP_UNSUPPORTED_FMT;
+        const uint8_t *src = reinterpret_cast<const uint8_t*>(scanline(y));
+        uint8_t *dst = &mid[static_cast<size_t>(y) * new_w * ch];
+
+        for (uint32_t i = 0; i < new_w; i++)
+        {
+            const int32_t *wgt = &x_weight[static_cast<size_t>(i) * x_taps];
+            const uint32_t first = x_start[i];
+
+            for (uint32_t c = 0; c < ch; c++)
+            {
+                int32_t acc = round;
+                for (uint32_t k = 0; k < x_taps; k++)
+                {
+                    const uint32_t sx = ((first + k) < w) ? (first + k) : (w - 1);
+                    acc += wgt[k] * src[sx * ch + c];
+                }
+
+                acc >>= RESAMPLE_FRAC_BITS;
+                dst[i * ch + c] = (acc < 0) ? 0 : ((acc > 255) ? 255 : acc);
+            }
+        }
     }
 
-    if (dib.bbp != 8 * sizeof(Pixel))
+    /* Vertical pass: (new_w x h) -> (new_w x new_h). */
+    for (uint32_t j = 0; j < new_h; j++)
     {
-        return BMP_UNSUPPORTED_FMT;
+        const int32_t *wgt = &y_weight[static_cast<size_t>(j) * y_taps];
+        const uint32_t first = y_start[j];
+        uint8_t *dst = reinterpret_cast<uint8_t*>(out.scanline(j));
+
+        for (uint32_t i = 0; i < new_w * ch; i++)
+        {
+            int32_t acc = round;
+            for (uint32_t k = 0; k < y_taps; k++)
+            {
+                const uint32_t sy = ((first + k) < h) ? (first + k) : (h - 1);
+                acc += wgt[k] * mid[static_cast<size_t>(sy) * new_w * ch + i];
+            }
+
+            acc >>= RESAMPLE_FRAC_BITS;
+            dst[i] = (acc < 0) ? 0 : ((acc > 255) ? 255 : acc);
+        }
     }
 
-    if (dib.compression != Bitmap::Compression::BI_RGB)
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::flip_vertical()
+{
+    if (!pixel_array || !loaded)
     {
-        return BMP_UNSUPPORTED_FMT;
+        return BMP_NOTINIT;
     }
 
-    if (dib.color_planes != 1)
+    if (frozen)
     {
-        return BMP_INVALID_DIB;
+        return BMP_FROZEN;
     }
 
-    // Assuming dib.vres == dib.hres
-    dpi = dib.hres;
+    const uint32_t w = dib.width;
+    const uint32_t h = dib.height;
+    std::vector<Pixel> tmp(w);
 
-    pixel_array = new Pixel[dib.width * dib.height];
-    if (!pixel_array)
+    for (uint32_t top = 0, bot = h - 1; top < bot; top++, bot--)
     {
-        return BMP_OOM;
+        memcpy(tmp.data(), scanline(top), w * sizeof(Pixel));
+        memcpy(scanline(top), scanline(bot), w * sizeof(Pixel));
+        memcpy(scanline(bot), tmp.data(), w * sizeof(Pixel));
     }
-    
-    fread((void*)pixel_array, dib.width * dib.height * sizeof(Pixel), 1, fptr);
-    loaded = true;
-    fclose(fptr);
 
+    mark_dirty(0, h - 1);
     return BMP_SUCCESS;
 }
 
 template <typename Pixel>
-BMPError Bitmap<Pixel>::create(const uint64_t width, const uint64_t height)
+BMPError Bitmap<Pixel>::flip_horizontal()
 {
-    if (loaded)
+    if (!pixel_array || !loaded)
     {
-        return BMP_ALREADY_INIT;
+        return BMP_NOTINIT;
     }
 
-    file_header.header_type = Bitmap::HeaderType::BM;
-    
-    dib.raw_size = (width * height) * sizeof(Pixel);
-    
-    file_header.offset = DIBHeaderType::BITMAPINFOHEADER + sizeof(FileHeader);
-    file_header.size = file_header.offset + dib.raw_size;
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
 
-    dib.size = DIBHeaderType::BITMAPINFOHEADER;
-    dib.height = height;
-    dib.width = width;
-    dib.color_planes = 1;
-    dib.bbp = static_cast<Bitmap::BitsPerPixel>(8 * sizeof(Pixel));
-    dib.compression = Bitmap::Compression::BI_RGB;
-    dib.n_colors = 0;
-    dib.icolors = 0;
+    const uint32_t w = dib.width;
+    const uint32_t h = dib.height;
+
+    for (uint32_t line = 0; line < h; line++)
+    {
+        Pixel *p = scanline(line);
+        for (uint32_t i = 0, j = w - 1; i < j; i++, j--)
+        {
+            const Pixel t = p[i];
+            p[i] = p[j];
+            p[j] = t;
+        }
+    }
+
+    mark_dirty(0, h - 1);
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError Bitmap<Pixel>::transpose()
+{
+    if (!pixel_array || !loaded)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (frozen)
+    {
+        return BMP_FROZEN;
+    }
 
-    // DPI × 39.3701 inches per metre
-    dib.vres = static_cast<uint32_t>(dpi * 39.3701);
-    dib.hres = dib.vres;
+    const uint32_t w = dib.width;
+    const uint32_t h = dib.height;
 
-    pixel_array = new Pixel[width * height];
-    if (!pixel_array)
+    /* The transposed image is h wide, so it gets its own stride, allocated under
+     * the same discipline as alloc_pixels. */
+    const uint64_t new_stride = aligned_stride(h);
+    const uint64_t bytes = new_stride * w;
+
+    Pixel *out = nullptr;
+    Ownership new_ownership = OwnHeap;
+    if (row_align <= alignof(std::max_align_t))
+    {
+        out = new Pixel[(bytes + sizeof(Pixel) - 1) / sizeof(Pixel)];
+    }
+    else
+    {
+        void *raw = nullptr;
+        if (posix_memalign(&raw, row_align, bytes) != 0)
+        {
+            raw = nullptr;
+        }
+        out = static_cast<Pixel*>(raw);
+        new_ownership = OwnAligned;
+    }
+
+    if (!out)
     {
         return BMP_OOM;
     }
 
-    memset(pixel_array, 0, width * height * sizeof(Pixel));
+    /* Square blocks small enough that source rows and destination columns both
+     * stay cache resident while a block is processed. */
+    const uint32_t block = 64;
+    uint8_t *out_bytes = reinterpret_cast<uint8_t*>(out);
 
-    loaded = true;
+    for (uint32_t by = 0; by < h; by += block)
+    {
+        const uint32_t ey = ((by + block) < h) ? (by + block) : h;
+        for (uint32_t bx = 0; bx < w; bx += block)
+        {
+            const uint32_t ex = ((bx + block) < w) ? (bx + block) : w;
+            for (uint32_t y = by; y < ey; y++)
+            {
+                const Pixel *src = scanline(y);
+                for (uint32_t x = bx; x < ex; x++)
+                {
+                    memcpy(out_bytes + static_cast<uint64_t>(x) * new_stride +
+                               static_cast<uint64_t>(y) * sizeof(Pixel),
+                           &src[x], sizeof(Pixel));
+                }
+            }
+        }
+    }
+
+    const uint64_t count = n_pixels;
+    release_storage();
+    pixel_array = out;
+    ownership = new_ownership;
+    n_pixels = count;
+    row_stride = new_stride;
+
+    dib.width = h;
+    dib.height = w;
+    dib.raw_size = disk_pitch(dib.width) * dib.height;
+    file_header.size = file_header.offset + dib.raw_size;
+
+    mark_dirty(0, dib.height - 1);
     return BMP_SUCCESS;
 }
 
 template <typename Pixel>
-BMPError Bitmap<Pixel>::write(const char * const filename)
+template <typename Fn>
+BMPError Bitmap<Pixel>::for_each_pixel(const Fn &fn)
 {
-    if (!loaded)
+    if (!pixel_array || !loaded)
     {
         return BMP_NOTINIT;
     }
 
-    FILE *fptr = fopen(filename, "wb+");
-    if (!fptr)
+    if (frozen)
     {
-        return BMP_FILEERROR;
+        return BMP_FROZEN;
     }
 
-    fwrite((void*)&file_header, sizeof(FileHeader), 1, fptr);
-    fwrite((void*)&dib, DIBHeaderType::BITMAPINFOHEADER, 1, fptr);
-    fwrite((void*)pixel_array, dib.width * dib.height * sizeof(Pixel), 1, fptr);
-    
-    // 4B alignment
-    size_t padding = file_header.size % sizeof(uint32_t);
-    if (padding > 0)
+    const uint32_t w = dib.width;
+    const uint32_t h = dib.height;
+
+    mark_dirty(0, h - 1);
+
+    for (uint32_t col = 0; col < h; col++)
     {
-        const uint8_t zero = 0;
-        for (uint8_t pad = 0; pad < 4 - padding; pad++)
+        Pixel *p = scanline(col);
+        for (uint32_t row = 0; row < w; row++)
         {
-            fwrite((void*)&zero, 1, 1, fptr);    
-        }        
+            fn(row, col, p[row]);
+        }
     }
 
-    fclose(fptr);
-
     return BMP_SUCCESS;
 }
 
 template <typename Pixel>
-BMPError Bitmap<Pixel>::get(const uint32_t row, const uint32_t col, Pixel &pixel) const
+template <typename Fn>
+BMPError Bitmap<Pixel>::for_each_tile(const uint32_t tile_w, const uint32_t tile_h,
+                                      const Fn &fn, uint32_t n_threads)
 {
     if (!pixel_array || !loaded)
     {
         return BMP_NOTINIT;
     }
 
-    const uint64_t idx = pixel_index(row, col);
-    if (idx >= pixel_max())
+    if (frozen)
     {
-        return BMP_OOB;
+        return BMP_FROZEN;
+    }
+
+    if (tile_w == 0 || tile_h == 0)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    if (n_threads == 0)
+    {
+        n_threads = std::thread::hardware_concurrency();
+        if (n_threads == 0)
+        {
+            n_threads = 1;
+        }
+    }
+
+    const uint32_t w = dib.width;
+    const uint32_t h = dib.height;
+    const uint64_t tiles_x = (w + tile_w - 1) / tile_w;
+    const uint64_t tiles_y = (h + tile_h - 1) / tile_h;
+    const uint64_t n_tiles = tiles_x * tiles_y;
+
+    std::atomic<uint64_t> cursor(0);
+
+    auto worker = [&]()
+    {
+        for (uint64_t tile = cursor.fetch_add(1); tile < n_tiles; tile = cursor.fetch_add(1))
+        {
+            const uint32_t col = (tile % tiles_x) * tile_w;
+            const uint32_t row = (tile / tiles_x) * tile_h;
+            const uint32_t clamped_w = (col + tile_w > w) ? (w - col) : tile_w;
+            const uint32_t clamped_h = (row + tile_h > h) ? (h - row) : tile_h;
+            fn(row, col, clamped_w, clamped_h);
+        }
+    };
+
+    if (n_threads == 1 || n_tiles == 1)
+    {
+        worker();
+        return BMP_SUCCESS;
+    }
+
+    if (n_threads > n_tiles)
+    {
+        n_threads = n_tiles;
+    }
+
+    std::vector<std::thread> pool;
+    pool.reserve(n_threads);
+    for (uint32_t t = 0; t < n_threads; t++)
+    {
+        pool.emplace_back(worker);
     }
 
-    memcpy(&pixel, &pixel_array[idx], sizeof(pixel));
+    for (uint32_t t = 0; t < n_threads; t++)
+    {
+        pool[t].join();
+    }
 
     return BMP_SUCCESS;
 }
 
 template <typename Pixel>
-BMPError Bitmap<Pixel>::set(const uint64_t row, const uint64_t col, Pixel &pixel)
+template <typename Fn>
+BMPError Bitmap<Pixel>::transform_parallel(const Fn &fn, uint32_t n_threads)
 {
     if (!pixel_array || !loaded)
     {
         return BMP_NOTINIT;
     }
 
-    const uint64_t idx = pixel_index(row, col);
-    if (idx >= pixel_max())
+    /* Full-width scanline bands sized so each band's working set fits in L2. */
+    const uint64_t row_bytes = static_cast<uint64_t>(dib.width) * sizeof(Pixel);
+    uint32_t band_h = (row_bytes > 0) ? (DEFAULT_TILE_BYTES / row_bytes) : 1;
+    if (band_h == 0)
     {
-        return BMP_OOB;
+        band_h = 1;
     }
 
-    memcpy(&pixel_array[idx], &pixel, sizeof(pixel));
+    const BMPError err = for_each_tile(dib.width, band_h,
+        [this, &fn](const uint32_t row, const uint32_t col,
+                    const uint32_t w, const uint32_t h)
+        {
+            for (uint32_t line = 0; line < h; line++)
+            {
+                Pixel *p = scanline(row + line) + col;
+                for (uint32_t i = 0; i < w; i++)
+                {
+                    fn(p[i]);
+                }
+            }
+        },
+        n_threads);
 
-    return BMP_SUCCESS;
+    if (err == BMP_SUCCESS)
+    {
+        mark_dirty(0, static_cast<uint32_t>(dib.height) - 1);
+    }
+
+    return err;
 }
 
 template <typename Pixel>
 int32_t Bitmap<Pixel>::width() const
 {
-    if (loaded)
+    if (loaded || lazy_fp)
     {
         return dib.width;
     }
@@ -679,9 +5157,9 @@ int32_t Bitmap<Pixel>::width() const
 template <typename Pixel>
 int32_t Bitmap<Pixel>::height() const
 {
-    if (loaded)
+    if (loaded || lazy_fp)
     {
-        return dib.width;
+        return dib.height;
     }
 
     return BMP_NOTINIT;
@@ -690,7 +5168,7 @@ int32_t Bitmap<Pixel>::height() const
 template <typename Pixel>
 BMPError Bitmap<Pixel>::WriteHeaderRsvd(const uint8_t data[4])
 {
-    if (!loaded)
+    if (!loaded && !lazy_fp)
     {
         return BMP_NOTINIT;
     }
@@ -711,7 +5189,7 @@ BMPError Bitmap<Pixel>::WriteHeaderRsvd(const uint8_t data[4])
 template <typename Pixel>
 BMPError Bitmap<Pixel>::ReadHeaderRsvd(uint8_t data[4]) const
 {
-    if (!loaded)
+    if (!loaded && !lazy_fp)
     {
         return BMP_NOTINIT;
     }
@@ -0,0 +1,181 @@
+/*!
+ * @file BitmapBatchLoader.h
+ * @brief A parallel multi-file Bitmap loader with a shared worker pool.
+ *
+ * @discussion Loading a directory of files serially leaves fast drives mostly idle,
+ *             because each file's parse-validate-allocate-read sequence is latency
+ *             bound. This loader keeps many loads outstanding at once and yields the
+ *             finished Bitmap objects as they complete, with a bound on how many
+ *             loaded-but-unconsumed images may be resident.
+ *
+ * @note 100-line Ruler
+ */
+
+#pragma once
+
+#include "Bitmap.h"
+
+#include <condition_variable>
+#include <deque>
+#include <mutex>
+
+/*!
+ * @class BitmapBatchLoader
+ * @brief Loads a list of Bitmap files across a thread pool and yields them as they finish.
+ *
+ * @tparam Pixel The type of the pixel to use. See Pixel namespace for pixel type definitions.
+ */
+template <typename Pixel>
+class BitmapBatchLoader
+{
+public:
+    /*!
+     * @struct Result
+     * @brief One completed load: the source filename, its status, and the image.
+     *
+     * @field filename The file this result corresponds to.
+     * @field status   The load's @p BMPError status; the bitmap is valid on BMP_SUCCESS.
+     * @field bitmap   The loaded image (moved out to the consumer).
+     */
+    struct Result
+    {
+        std::string filename;
+        BMPError status;
+        Bitmap<Pixel> bitmap;
+    };
+
+    /*!
+     * Constructor
+     * @param[in] _n_threads   Worker count; 0 selects the hardware concurrency.
+     * @param[in] _max_pending Maximum completed-but-unconsumed images resident at once.
+     */
+    BitmapBatchLoader(uint32_t _n_threads = 0, const uint32_t _max_pending = 16) :
+        n_threads(_n_threads), max_pending(_max_pending), next_file(0), active_workers(0)
+    {
+        if (n_threads == 0)
+        {
+            n_threads = std::thread::hardware_concurrency();
+            if (n_threads == 0)
+            {
+                n_threads = 1;
+            }
+        }
+    }
+
+    /*!
+     * Destructor - drains any unconsumed results and joins the pool.
+     */
+    ~BitmapBatchLoader()
+    {
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            /* Unblock workers stuck on the pending bound; discard their output. */
+            next_file.store(files.size());
+            done.clear();
+            space_cv.notify_all();
+        }
+
+        for (size_t t = 0; t < pool.size(); t++)
+        {
+            pool[t].join();
+        }
+    }
+
+    /*!
+     * @function start
+     * @brief Begin loading a list of files across the worker pool.
+     *
+     * @param[in] filenames The files to load, in any order.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError start(const std::vector<std::string> &filenames)
+    {
+        if (!pool.empty())
+        {
+            return BMP_ALREADY_INIT;
+        }
+
+        files = filenames;
+        active_workers.store(n_threads);
+
+        pool.reserve(n_threads);
+        for (uint32_t t = 0; t < n_threads; t++)
+        {
+            pool.emplace_back(&BitmapBatchLoader::worker, this);
+        }
+
+        return BMP_SUCCESS;
+    }
+
+    /*!
+     * @function next
+     * @brief Take the next completed load, blocking until one is available.
+     *
+     * @param[out] out The completed result, moved to the caller.
+     *
+     * @return true if a result was produced; false when the batch is fully drained.
+     */
+    bool next(Result &out)
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        done_cv.wait(lock, [this]() {
+            return !done.empty() || active_workers.load() == 0;
+        });
+
+        if (done.empty())
+        {
+            return false;
+        }
+
+        out = std::move(done.front());
+        done.pop_front();
+        space_cv.notify_one();
+        return true;
+    }
+
+private:
+    /*!
+     * @function worker
+     * @brief Pool thread body: pull filenames off the shared cursor and load them.
+     */
+    void worker()
+    {
+        for (;;)
+        {
+            const size_t i = next_file.fetch_add(1);
+            if (i >= files.size())
+            {
+                break;
+            }
+
+            Result r;
+            r.filename = files[i];
+            r.status = r.bitmap.load(files[i].c_str());
+
+            std::unique_lock<std::mutex> lock(mtx);
+            space_cv.wait(lock, [this]() {
+                return done.size() < max_pending || next_file.load() >= files.size();
+            });
+            done.push_back(std::move(r));
+            done_cv.notify_one();
+        }
+
+        if (active_workers.fetch_sub(1) == 1)
+        {
+            std::unique_lock<std::mutex> lock(mtx);
+            done_cv.notify_all();
+        }
+    }
+
+    uint32_t n_threads;
+    const uint32_t max_pending;
+    std::vector<std::string> files;
+    std::atomic<size_t> next_file;
+    std::atomic<uint32_t> active_workers;
+    std::vector<std::thread> pool;
+    std::deque<Result> done;
+    std::mutex mtx;
+    std::condition_variable done_cv;
+    std::condition_variable space_cv;
+}; /* class BitmapBatchLoader<> */
@@ -0,0 +1,292 @@
+/*!
+ * @file BitmapCache.h
+ * @brief A shared, budget-bounded cache of immutable loaded Bitmap images.
+ *
+ * @discussion Workloads that load the same template or background images over and
+ *             over pay the full parse-validate-allocate-read cost every time. This
+ *             cache keys loaded images by filename and file mtime and hands out
+ *             pinned, frozen aliases of a single shared pixel buffer, so a repeat
+ *             load is pointer setup instead of file I/O. Total resident pixel bytes
+ *             are bounded by a configurable budget with least-recently-used
+ *             eviction; evicted images stay alive until their last handle drops.
+ *
+ * @note 100-line Ruler
+ */
+
+#pragma once
+
+#include "Bitmap.h"
+
+#include <list>
+#include <map>
+#include <memory>
+#include <mutex>
+
+/*!
+ * @class BitmapCache
+ * @brief Process-wide cache of loaded images, shared between all takers of a file.
+ *
+ * @tparam Pixel The type of the pixel to use. See Pixel namespace for pixel type definitions.
+ */
+template <typename Pixel>
+class BitmapCache
+{
+private:
+    /*!
+     * @struct Entry
+     * @brief One cached image: its source identity and the owning Bitmap.
+     *
+     * @field filename The source file this entry was loaded from.
+     * @field mtime    The source file's modification time at load; a later mtime
+     *                 on disk invalidates the entry.
+     * @field image    The loaded image owning the shared pixel buffer.
+     * @field bytes    The pixel storage size counted against the budget.
+     */
+    struct Entry
+    {
+        std::string filename;
+        time_t mtime;
+        Bitmap<Pixel> image;
+        uint64_t bytes;
+    };
+
+public:
+    /*!
+     * @class Handle
+     * @brief A pinned, read-only alias of a cached image.
+     *
+     * @discussion Holding a Handle keeps the shared pixels alive even across
+     *             eviction. The exposed Bitmap adopts the cache's buffer without
+     *             ownership and is frozen, so any number of handles may read the
+     *             same pixels concurrently. Handles are movable, not copyable.
+     */
+    class Handle
+    {
+    public:
+        Handle() {}
+
+        /*!
+         * @function bitmap
+         * @brief The cached image; frozen, valid while this handle is alive.
+         */
+        const Bitmap<Pixel> &bitmap() const { return alias; }
+
+        /*!
+         * @function valid
+         * @brief Whether this handle is attached to a cached image.
+         */
+        bool valid() const { return entry != nullptr; }
+
+    private:
+        friend class BitmapCache;
+        std::shared_ptr<Entry> entry;
+        Bitmap<Pixel> alias;
+    };
+
+    /*!
+     * Constructor
+     * @param[in] _max_bytes Pixel-byte budget before least-recently-used eviction.
+     */
+    BitmapCache(const uint64_t _max_bytes = DEFAULT_BUDGET) :
+        max_bytes(_max_bytes), resident(0), hit_count(0), miss_count(0) {}
+
+    /*!
+     * @function instance
+     * @brief The process-wide cache shared by all callers of this pixel type.
+     */
+    static BitmapCache &instance()
+    {
+        static BitmapCache cache;
+        return cache;
+    }
+
+    /*!
+     * @function acquire
+     * @brief Get a pinned handle to a file's image, loading it on first use.
+     *
+     * @discussion A hit returns in O(1) with no file I/O beyond an mtime check.
+     *             On a miss the file is loaded outside the cache lock, so slow
+     *             reads do not serialize unrelated callers; if two threads race
+     *             on the same miss, one load wins and the other is discarded.
+     *             A file whose mtime changed since caching is reloaded.
+     *
+     * @param[in]  filename The name of the file to load.
+     * @param[out] out      The pinned handle upon success.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError acquire(const char * const filename, Handle &out);
+
+    /*!
+     * @function set_budget
+     * @brief Change the pixel-byte budget, evicting immediately if over it.
+     *
+     * @param[in] bytes The new budget in bytes.
+     */
+    void set_budget(const uint64_t bytes)
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        max_bytes = bytes;
+        evict_to_budget();
+    }
+
+    /*!
+     * @function clear
+     * @brief Drop every cached entry; pinned handles keep their pixels alive.
+     */
+    void clear()
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        index.clear();
+        lru.clear();
+        resident = 0;
+    }
+
+    /*!
+     * @function resident_bytes
+     * @brief The pixel bytes currently counted against the budget.
+     */
+    uint64_t resident_bytes() const
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        return resident;
+    }
+
+    /*!
+     * @function hits
+     * @brief The number of acquires served from the cache.
+     */
+    uint64_t hits() const
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        return hit_count;
+    }
+
+    /*!
+     * @function misses
+     * @brief The number of acquires that had to load the file.
+     */
+    uint64_t misses() const
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        return miss_count;
+    }
+
+    /*!
+     * @constant DEFAULT_BUDGET
+     * @brief The default pixel-byte budget: 256MB.
+     */
+    static const uint64_t DEFAULT_BUDGET = UINT64_C(256) * 1024 * 1024;
+
+private:
+    /*!
+     * @function evict_to_budget
+     * @brief Drop least-recently-used entries until the budget holds. Lock held.
+     */
+    void evict_to_budget()
+    {
+        while (resident > max_bytes && !lru.empty())
+        {
+            const std::shared_ptr<Entry> victim = lru.back();
+            resident -= victim->bytes;
+            index.erase(victim->filename);
+            lru.pop_back();
+        }
+    }
+
+    /*!
+     * @function make_handle
+     * @brief Build a pinned, frozen alias of an entry's pixels.
+     */
+    static BMPError make_handle(const std::shared_ptr<Entry> &entry, Handle &out)
+    {
+        Bitmap<Pixel> alias;
+        const BMPError err = alias.adopt(entry->image.row_ptr(0),
+                                         entry->image.width(), entry->image.height(),
+                                         false, entry->image.stride());
+        if (err != BMP_SUCCESS)
+        {
+            return err;
+        }
+
+        alias.freeze();
+        out.entry = entry;
+        out.alias = std::move(alias);
+        return BMP_SUCCESS;
+    }
+
+    uint64_t max_bytes;
+    uint64_t resident;
+    uint64_t hit_count;
+    uint64_t miss_count;
+    /* Most recently used at the front; the map holds each entry's LRU position. */
+    std::list<std::shared_ptr<Entry>> lru;
+    std::map<std::string, typename std::list<std::shared_ptr<Entry>>::iterator> index;
+    mutable std::mutex mtx;
+}; /* class BitmapCache<> */
+
+/* Templated Base Class Definitions */
+
+template <typename Pixel>
+BMPError BitmapCache<Pixel>::acquire(const char * const filename, Handle &out)
+{
+    struct stat file_stat;
+    if (stat(filename, &file_stat) != 0)
+    {
+        return BMP_FILEERROR;
+    }
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        typename std::map<std::string,
+                          typename std::list<std::shared_ptr<Entry>>::iterator>::iterator
+            found = index.find(filename);
+        if (found != index.end())
+        {
+            if ((*found->second)->mtime == file_stat.st_mtime)
+            {
+                hit_count++;
+                lru.splice(lru.begin(), lru, found->second);
+                return make_handle(lru.front(), out);
+            }
+
+            /* Stale: the file changed on disk since it was cached. */
+            resident -= (*found->second)->bytes;
+            lru.erase(found->second);
+            index.erase(found);
+        }
+        miss_count++;
+    }
+
+    /* Load outside the lock; the file read dominates and must not serialize
+     * other callers. */
+    std::shared_ptr<Entry> entry(new Entry());
+    entry->filename = filename;
+    entry->mtime = file_stat.st_mtime;
+    const BMPError err = entry->image.load(filename);
+    if (err != BMP_SUCCESS)
+    {
+        return err;
+    }
+    entry->bytes = entry->image.stride() * entry->image.height();
+
+    {
+        std::unique_lock<std::mutex> lock(mtx);
+        typename std::map<std::string,
+                          typename std::list<std::shared_ptr<Entry>>::iterator>::iterator
+            raced = index.find(filename);
+        if (raced != index.end())
+        {
+            /* Another thread loaded the same file first; share its copy. */
+            lru.splice(lru.begin(), lru, raced->second);
+            return make_handle(lru.front(), out);
+        }
+
+        lru.push_front(entry);
+        index[entry->filename] = lru.begin();
+        resident += entry->bytes;
+        evict_to_budget();
+    }
+
+    return make_handle(entry, out);
+}
@@ -0,0 +1,229 @@
+/*!
+ * @file BitmapStreamWriter.h
+ * @brief A streaming scanline writer for generating Bitmap images out-of-core.
+ *
+ * @discussion Unlike Bitmap<Pixel>::create + write, which hold the entire pixel array
+ *             in memory, this writer emits the headers once and then streams scanlines
+ *             straight to disk, keeping memory O(row) instead of O(image).
+ *
+ * @note 100-line Ruler
+ */
+
+#pragma once
+
+#include "Bitmap.h"
+
+/*!
+ * @class BitmapStreamWriter
+ * @brief Object for writing a Bitmap image scanline-by-scanline without a full pixel array.
+ *
+ * @discussion The output geometry is fixed at @p open time; callers then push scanlines
+ *             (or batches of scanlines) in file order via @p append_rows until the image
+ *             is complete, and @p close finalizes the file. Each row is written at the
+ *             format's 4-byte-padded pitch.
+ *
+ * @tparam Pixel The type of the pixel to use. See Pixel namespace for pixel type definitions.
+ */
+template <typename Pixel>
+class BitmapStreamWriter
+{
+public:
+    /*!
+     * Constructor
+     * @param[in] _dpi Dots per pixel in inches per metre
+     */
+    BitmapStreamWriter(const uint32_t _dpi = DEFAULT_DPI) :
+        fptr(nullptr), rows_written(0), dpi(_dpi) {}
+
+    /*!
+     * Destructor
+     */
+    ~BitmapStreamWriter()
+    {
+        if (fptr)
+        {
+            close();
+        }
+    }
+
+    /*!
+     * @function open
+     * @brief Open the output file and write the Bitmap headers for a fixed geometry.
+     *
+     * @param[in] filename The name of the file to write to.
+     * @param[in] width    The image width in pixels.
+     * @param[in] height   The image height in scanlines.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError open(const char * const filename, const uint64_t width, const uint64_t height);
+
+    /*!
+     * @function append_rows
+     * @brief Append scanlines to the output file, in file order.
+     *
+     * @discussion Rows are flushed through a bounded stdio buffer; nothing beyond that
+     *             buffer and the headers is ever resident.
+     *
+     * @param[in] rows A buffer of @p n scanlines of @p width pixels each.
+     * @param[in] n    The number of scanlines in @p rows.
+     *
+     * @return BMP_SUCCESS upon sucess, else relevant @p BMPError status.
+     */
+    BMPError append_rows(const Pixel * const rows, const uint64_t n);
+
+    /*!
+     * @function close
+     * @brief Close the output file.
+     *
+     * @return BMP_SUCCESS upon sucess. BMP_BAD_INPUT if fewer rows than @p height were
+     *         appended (the file is still closed).
+     */
+    BMPError close();
+
+private:
+    /*!
+     * @var fptr
+     * @brief The open output stream, or nullptr when closed.
+     */
+    FILE *fptr;
+
+    /*!
+     * @var rows_written
+     * @brief The number of scanlines appended so far.
+     */
+    uint64_t rows_written;
+
+    /*!
+     * @var dpi
+     * @brief Dots per inch setting for this instance.
+     */
+    uint32_t dpi;
+
+    /*!
+     * @var dib
+     * @brief The Device Independent header for the output image.
+     */
+    typename Bitmap<Pixel>::BitmapInfoHeader dib;
+
+    /*!
+     * @var file_header
+     * @brief The file header for the output image.
+     */
+    typename Bitmap<Pixel>::FileHeader file_header;
+}; /* class BitmapStreamWriter<> */
+
+/* Templated Base Class Definitions */
+
+template <typename Pixel>
+BMPError BitmapStreamWriter<Pixel>::open(const char * const filename,
+                                         const uint64_t width, const uint64_t height)
+{
+    if (fptr)
+    {
+        return BMP_ALREADY_INIT;
+    }
+
+    fptr = fopen(filename, "wb+");
+    if (!fptr)
+    {
+        return BMP_FILEERROR;
+    }
+
+    /* Bound the resident buffer: scanlines stream through 1MB of stdio buffering. */
+    setvbuf(fptr, nullptr, _IOFBF, 1 << 20);
+
+    file_header.header_type = Bitmap<Pixel>::HeaderType::BM;
+    file_header._rsvd1[0] = file_header._rsvd1[1] = 0;
+    file_header._rsvd2[0] = file_header._rsvd2[1] = 0;
+
+    /* Rows are padded to 4 bytes in the file, per the format. */
+    dib.raw_size = ((width * sizeof(Pixel) + 3) & ~UINT64_C(3)) * height;
+
+    file_header.offset = Bitmap<Pixel>::DIBHeaderType::BITMAPINFOHEADER +
+                         sizeof(typename Bitmap<Pixel>::FileHeader);
+    file_header.size = file_header.offset + dib.raw_size;
+
+    dib.size = Bitmap<Pixel>::DIBHeaderType::BITMAPINFOHEADER;
+    dib.height = height;
+    dib.width = width;
+    dib.color_planes = 1;
+    dib.bbp = static_cast<typename Bitmap<Pixel>::BitsPerPixel>(8 * sizeof(Pixel));
+    dib.compression = Bitmap<Pixel>::Compression::BI_RGB;
+    dib.n_colors = 0;
+    dib.icolors = 0;
+
+    // DPI × 39.3701 inches per metre
+    dib.vres = static_cast<uint32_t>(dpi * 39.3701);
+    dib.hres = dib.vres;
+
+    fwrite((void*)&file_header, sizeof(file_header), 1, fptr);
+    fwrite((void*)&dib, Bitmap<Pixel>::DIBHeaderType::BITMAPINFOHEADER, 1, fptr);
+
+    rows_written = 0;
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError BitmapStreamWriter<Pixel>::append_rows(const Pixel * const rows, const uint64_t n)
+{
+    if (!fptr)
+    {
+        return BMP_NOTINIT;
+    }
+
+    if (!rows)
+    {
+        return BMP_BAD_INPUT;
+    }
+
+    if ((rows_written + n) > static_cast<uint64_t>(dib.height))
+    {
+        return BMP_OOB;
+    }
+
+    const uint64_t payload = static_cast<uint64_t>(dib.width) * sizeof(Pixel);
+    const uint64_t pad_len = ((payload + 3) & ~UINT64_C(3)) - payload;
+
+    if (pad_len == 0)
+    {
+        /* Packed rows are already file-pitch rows: one bulk write. */
+        if (fwrite((void*)rows, payload, n, fptr) != n)
+        {
+            return BMP_FILEERROR;
+        }
+    }
+    else
+    {
+        const uint8_t pad[sizeof(uint32_t)] = {0, 0, 0, 0};
+        for (uint64_t i = 0; i < n; i++)
+        {
+            if (fwrite((void*)&rows[i * dib.width], payload, 1, fptr) != 1 ||
+                fwrite((void*)pad, pad_len, 1, fptr) != 1)
+            {
+                return BMP_FILEERROR;
+            }
+        }
+    }
+
+    rows_written += n;
+    return BMP_SUCCESS;
+}
+
+template <typename Pixel>
+BMPError BitmapStreamWriter<Pixel>::close()
+{
+    if (!fptr)
+    {
+        return BMP_NOTINIT;
+    }
+
+    /* Each appended row carried its own 4-byte alignment padding, so the file
+     * ends exactly at file_header.size. */
+    const bool complete = (rows_written == static_cast<uint64_t>(dib.height));
+
+    fclose(fptr);
+    fptr = nullptr;
+
+    return complete ? BMP_SUCCESS : BMP_BAD_INPUT;
+}
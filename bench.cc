@@ -0,0 +1,193 @@
+/*!
+ * @file bench.cc
+ * @brief Throughput benchmarks for the Bitmap library.
+ *
+ * @discussion Measures load bandwidth across file sizes, get/set call rates, a
+ *             full-frame transform matching main.cc's loop, and the create+write
+ *             round trip. Results are emitted as CSV on stdout
+ *             (benchmark,param,iters,seconds,value,unit) so they can be tracked
+ *             across commits. Build and run via `make bench && ./bench`.
+ *
+ *             An optional argument caps the largest square image edge used for the
+ *             size sweep (default 2048); e.g. `./bench 8192` for a deeper sweep.
+ *
+ * @note 100-line Ruler
+ */
+
+#include "Bitmap.h"
+
+#include <chrono>
+#include <cstdio>
+
+using Clock = std::chrono::steady_clock;
+
+/*! @brief Seconds elapsed since @p start. */
+static double since(const Clock::time_point start)
+{
+    return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/*! @brief Emit one CSV result row. */
+static void report(const char *name, const uint64_t param, const uint64_t iters,
+                   const double seconds, const double value, const char *unit)
+{
+    printf("%s,%llu,%llu,%.6f,%.2f,%s\n",
+           name,
+           static_cast<unsigned long long>(param),
+           static_cast<unsigned long long>(iters),
+           seconds, value, unit);
+}
+
+/*! @brief Write a square fixture file of the given edge and return its byte size. */
+static uint64_t make_fixture(const char *path, const uint32_t edge)
+{
+    Bitmap<Pixel::BGR24> bmp;
+    if (bmp.create(edge, edge) != BMP_SUCCESS || bmp.write(path) != BMP_SUCCESS)
+    {
+        return 0;
+    }
+
+    return static_cast<uint64_t>(edge) * edge * sizeof(Pixel::BGR24);
+}
+
+/*! @brief load() bandwidth across file sizes. */
+static void bench_load(const uint32_t max_edge)
+{
+    const uint32_t edges[] = {16, 64, 256, 1024, 2048, 4096, 8192, 16384};
+    const char *path = "bench_load_tmp.bmp";
+
+    for (size_t i = 0; i < sizeof(edges) / sizeof(edges[0]); i++)
+    {
+        const uint32_t edge = edges[i];
+        if (edge > max_edge)
+        {
+            break;
+        }
+
+        const uint64_t bytes = make_fixture(path, edge);
+        if (bytes == 0)
+        {
+            continue;
+        }
+
+        /* Repeat small loads so the sample is not all timer noise. */
+        const uint64_t iters = (bytes < (1 << 20)) ? 100 : 5;
+        const Clock::time_point start = Clock::now();
+        for (uint64_t it = 0; it < iters; it++)
+        {
+            Bitmap<Pixel::BGR24> bmp;
+            bmp.load(path);
+        }
+        const double secs = since(start);
+
+        report("load", bytes, iters, secs,
+               (static_cast<double>(bytes) * iters) / secs / 1e6, "MB/s");
+        remove(path);
+    }
+}
+
+/*! @brief Per-call get()/set() rates. */
+static void bench_get_set(const uint32_t edge)
+{
+    Bitmap<Pixel::BGR24> bmp;
+    if (bmp.create(edge, edge) != BMP_SUCCESS)
+    {
+        return;
+    }
+
+    const uint64_t total = static_cast<uint64_t>(edge) * edge;
+    Pixel::BGR24 p = {0, 0, 0};
+
+    Clock::time_point start = Clock::now();
+    for (uint32_t i = 0; i < edge; i++)
+    {
+        for (uint32_t j = 0; j < edge; j++)
+        {
+            bmp.get(i, j, p);
+        }
+    }
+    double secs = since(start);
+    report("get", edge, total, secs, static_cast<double>(total) / secs / 1e6, "Mops/s");
+
+    start = Clock::now();
+    for (uint32_t i = 0; i < edge; i++)
+    {
+        for (uint32_t j = 0; j < edge; j++)
+        {
+            bmp.set(i, j, p);
+        }
+    }
+    secs = since(start);
+    report("set", edge, total, secs, static_cast<double>(total) / secs / 1e6, "Mops/s");
+}
+
+/*! @brief The main.cc-style full-frame transform: zero the red channel per pixel. */
+static void bench_transform(const uint32_t edge)
+{
+    Bitmap<Pixel::BGR24> bmp;
+    if (bmp.create(edge, edge) != BMP_SUCCESS)
+    {
+        return;
+    }
+
+    const uint64_t total = static_cast<uint64_t>(edge) * edge;
+
+    const Clock::time_point start = Clock::now();
+    for (int32_t i = 0; i < bmp.width(); i++)
+    {
+        for (int32_t j = 0; j < bmp.height(); j++)
+        {
+            Pixel::BGR24 p;
+            bmp.get(i, j, p);
+            p.r = 0;
+            bmp.set(i, j, p);
+        }
+    }
+    const double secs = since(start);
+
+    report("transform", edge, total, secs,
+           static_cast<double>(total) / secs / 1e6, "Mpix/s");
+}
+
+/*! @brief create() + write() round trip throughput. */
+static void bench_create_write(const uint32_t edge)
+{
+    const char *path = "bench_write_tmp.bmp";
+    const uint64_t bytes = static_cast<uint64_t>(edge) * edge * sizeof(Pixel::BGR24);
+    const uint64_t iters = 5;
+
+    const Clock::time_point start = Clock::now();
+    for (uint64_t it = 0; it < iters; it++)
+    {
+        Bitmap<Pixel::BGR24> bmp;
+        bmp.create(edge, edge);
+        bmp.write(path);
+    }
+    const double secs = since(start);
+
+    report("create_write", bytes, iters, secs,
+           (static_cast<double>(bytes) * iters) / secs / 1e6, "MB/s");
+    remove(path);
+}
+
+int main(int argc, char *argv[])
+{
+    uint32_t max_edge = 2048;
+    if (argc > 1)
+    {
+        const long arg = strtol(argv[1], nullptr, 10);
+        if (arg > 0)
+        {
+            max_edge = static_cast<uint32_t>(arg);
+        }
+    }
+
+    printf("benchmark,param,iters,seconds,value,unit\n");
+
+    bench_load(max_edge);
+    bench_get_set((max_edge < 1024) ? max_edge : 1024);
+    bench_transform((max_edge < 1024) ? max_edge : 1024);
+    bench_create_write((max_edge < 1024) ? max_edge : 1024);
+
+    return 0;
+}